@@ -0,0 +1,75 @@
+/*******************************************************************************
+  Button.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+
+#include "Button.h"
+
+ButtonArray::ButtonArray(const uint8_t* pins, uint8_t* settleStartTicks, uint8_t numButtons) :
+  mPins(pins),
+  mSettleStartTicks(settleStartTicks),
+  mNumButtons(numButtons)
+{
+}
+
+void ButtonArray::StartSettling(uint8_t buttonIndex, unsigned long curTimeMs)
+{
+  mSettleStartTicks[buttonIndex] = (uint8_t)curTimeMs;
+  mSettlingButtons |= GetButtonMask(buttonIndex);
+}
+
+// The elapsed time is computed in 8 bits, which wraps after 256 ms; so a settling button must be checked,
+// by this method or ExpireSettledButtons(), within 256 ms of StartSettling(). If it is not (e.g. loop() was blocked),
+// the button may be reported as settling for up to the debounce time more; it is never reported settled too early.
+bool ButtonArray::IsSettled(uint8_t buttonIndex, unsigned long curTimeMs)
+{
+  uint64_t buttonMask = GetButtonMask(buttonIndex);
+  if ((mSettlingButtons & buttonMask) == 0)
+  {
+    return true;
+  }
+
+  uint8_t elapsedTimeMs = (uint8_t)curTimeMs - mSettleStartTicks[buttonIndex];
+  if (elapsedTimeMs < mDebounceDelayMs)
+  {
+    return false;
+  }
+
+  mSettlingButtons &= ~buttonMask;
+  return true;
+}
+
+// This method visits only the settling buttons; there are none while no buttons are played.
+void ButtonArray::ExpireSettledButtons(unsigned long curTimeMs)
+{
+  uint64_t settlingButtons = mSettlingButtons;
+  while (settlingButtons != 0)
+  {
+    uint8_t buttonIndex = __builtin_ctzll(settlingButtons);
+    settlingButtons &= settlingButtons - 1;
+
+    IsSettled(buttonIndex, curTimeMs);
+  }
+}
@@ -24,17 +24,100 @@
   
  ******************************************************************************/
 
+
 #ifndef Button_H
 #define Button_H
 
-#include "ButtonState.h"
+#include <Arduino.h>
+
+#include "SharedConstants.h"
+
+// The settle time of a button is kept in 8 bits, so the debounce time must fit in 8 bits.
+static_assert(DebounceDelayMs < 256, "DebounceDelayMs must be less than 256 ms.");
 
-typedef struct
+// This class holds the state of an array of buttons, structure-of-arrays style.
+// The active (pressed) state, and the debounce flags, are packed bitmaps with one bit per button; bit n is button index n.
+// A whole bank of buttons is compared with a few word operations, e.g. against the pressed buttons read from the port input registers.
+// The debounce time of each button is a single byte; the low 8 bits of millis() when the button started settling.
+// Handlers use the button-level accessors, IsActive() and GetPin().
+class ButtonArray
 {
-  ButtonState buttonState;
-  
-  // The last time the button state was toggled. Used for debouncing button.
-  unsigned long lastToggleTimeMs;
-} Button;
+public:
+  ButtonArray(const uint8_t* pins, uint8_t* settleStartTicks, uint8_t numButtons);
+
+  uint8_t GetNumButtons() const { return mNumButtons; }
+  uint8_t GetPin(uint8_t buttonIndex) const { return mPins[buttonIndex]; }
+
+  bool IsActive(uint8_t buttonIndex) const { return (mActiveButtons & GetButtonMask(buttonIndex)) != 0; }
+  void SetActive(uint8_t buttonIndex, bool isActive) { SetBit(mActiveButtons, buttonIndex, isActive); }
+
+  // Returns the bitmap of active buttons.
+  uint64_t GetActiveButtons() const { return mActiveButtons; }
+
+  // Used by EagerPressDebounce while a release is settling.
+  bool IsReleasePending(uint8_t buttonIndex) const { return (mReleasePendingButtons & GetButtonMask(buttonIndex)) != 0; }
+  void SetReleasePending(uint8_t buttonIndex, bool isReleasePending) { SetBit(mReleasePendingButtons, buttonIndex, isReleasePending); }
+
+  // Starts the debounce time of the button, at the time passed in.
+  void StartSettling(uint8_t buttonIndex, unsigned long curTimeMs);
+
+  // Returns true if the debounce time of the button has elapsed, or was never started.
+  bool IsSettled(uint8_t buttonIndex, unsigned long curTimeMs);
+
+  // The debounce time; DebounceDelayMs unless set, e.g. by the RH Arduino for the LH buttons. It is kept in 8 bits, as the settle times are.
+  uint8_t GetDebounceDelayMs() const { return mDebounceDelayMs; }
+  void SetDebounceDelayMs(uint8_t debounceDelayMs) { mDebounceDelayMs = debounceDelayMs; }
+
+  // Ends the debounce time of the buttons whose debounce time has elapsed; call once per scan.
+  void ExpireSettledButtons(unsigned long curTimeMs);
+
+  // Returns true if the debounce time of any button may not have elapsed, or a release is pending.
+  bool IsAnyButtonSettling() const { return mSettlingButtons != 0 || mReleasePendingButtons != 0; }
+
+  static uint64_t GetButtonMask(uint8_t buttonIndex) { return (uint64_t)1 << buttonIndex; }
+
+protected:
+  // The default constructor is protected to prevent its usage.
+  ButtonArray();
+
+  static void SetBit(uint64_t& bitmap, uint8_t buttonIndex, bool isSet)
+  {
+    if (isSet)
+    {
+      bitmap |= GetButtonMask(buttonIndex);
+    }
+    else
+    {
+      bitmap &= ~GetButtonMask(buttonIndex);
+    }
+  }
+
+private:
+  const uint8_t* mPins;
+  uint8_t* mSettleStartTicks;
+  uint8_t mNumButtons;
+  uint8_t mDebounceDelayMs = DebounceDelayMs;
+
+  uint64_t mActiveButtons = 0;
+  uint64_t mReleasePendingButtons = 0;
+
+  // Buttons whose debounce time may not have elapsed yet; mSettleStartTicks is only valid for these.
+  uint64_t mSettlingButtons = 0;
+};
+
+// This class is a ButtonArray of NumButtons buttons, with the storage of their settle times.
+template <uint8_t NumButtons>
+class ButtonArrayOf : public ButtonArray
+{
+  static_assert(NumButtons <= 64, "A ButtonArray holds at most 64 buttons.");
+
+public:
+  ButtonArrayOf(const uint8_t* pins) : ButtonArray(pins, mSettleStartTicksStorage, NumButtons)
+  {
+  }
+
+private:
+  uint8_t mSettleStartTicksStorage[NumButtons];
+};
 
 #endif
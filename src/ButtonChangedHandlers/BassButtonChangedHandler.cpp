@@ -39,7 +39,7 @@ BassButtonChangedHandler::BassButtonChangedHandler() : NoteButtonChangedHandler(
   mMidiChannel = BassNotesZeroBasedMidiChannel;
 }
 
-void BassButtonChangedHandler::HandleButtonChange(Button* buttons, byte buttonIndex)
+void BassButtonChangedHandler::HandleButtonChange(ButtonArray& buttons, byte buttonIndex)
 {
   // The following is used to map pin index to MIDI note number.
   const byte LowestNote = MIDI_C - 2*MIDI_OCTAVE;
@@ -48,7 +48,7 @@ void BassButtonChangedHandler::HandleButtonChange(Button* buttons, byte buttonIn
   // Convert button index to MIDI note number.
   byte noteNum = LowestNote + buttonIndex;
 
-  SendMidiNoteCommand(noteNum, buttons[buttonIndex].buttonState.active, mMidiChannel, "BassButtonChangedHandler");
+  SendMidiNoteCommand(noteNum, buttons.IsActive(buttonIndex), mMidiChannel, "BassButtonChangedHandler");
 }
 
 #endif // BUILD_RIGHT_HAND_MASTER
\ No newline at end of file
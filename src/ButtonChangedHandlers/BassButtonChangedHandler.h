@@ -41,7 +41,7 @@ class BassButtonChangedHandler : public NoteButtonChangedHandler
 public:
   BassButtonChangedHandler();
 
-  virtual void HandleButtonChange(Button* button, byte buttonIndex);
+  virtual void HandleButtonChange(ButtonArray& buttons, byte buttonIndex);
 };
 
 #endif // BUILD_RIGHT_HAND_MASTER
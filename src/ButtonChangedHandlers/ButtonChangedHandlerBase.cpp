@@ -35,6 +35,11 @@ ButtonChangedHandlerBase::ButtonChangedHandlerBase()
 {
 }
 
-void ButtonChangedHandlerBase::HandleButtonChange(Button* button, byte buttonIndex)
+void ButtonChangedHandlerBase::HandleButtonChange(ButtonArray& buttons, byte buttonIndex)
 {
+}
+
+void ButtonChangedHandlerBase::HandleButtonEvent(ButtonArray& buttons, const ButtonEvent& buttonEvent)
+{
+  HandleButtonChange(buttons, buttonEvent.buttonIndex);
 }
\ No newline at end of file
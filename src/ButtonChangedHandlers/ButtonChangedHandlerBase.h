@@ -31,6 +31,7 @@
 
 #include "../MIDIAccordion.h"
 #include "../Button.h"
+#include "../ButtonEvent.h"
 #include "../SharedConstants.h"
 
 // This abstract class provides an interface to handle button state changes. 
@@ -39,7 +40,11 @@ class ButtonChangedHandlerBase
 public:
   ButtonChangedHandlerBase();
 
-  virtual void HandleButtonChange(Button* button, byte buttonIndex) = 0;
+  virtual void HandleButtonChange(ButtonArray& buttons, byte buttonIndex) = 0;
+
+  // Handles a button state change, with the time it was sampled, and its bank. The button state has already been saved in the button.
+  // The default implementation calls HandleButtonChange(); override it to use the event's timestamp.
+  virtual void HandleButtonEvent(ButtonArray& buttons, const ButtonEvent& buttonEvent);
 };
 
 #endif
@@ -39,7 +39,7 @@ ChordButtonChangedHandler::ChordButtonChangedHandler() : NoteButtonChangedHandle
     mMidiChannel = ChordsZeroBasedMidiChannel;
 }
 
-void ChordButtonChangedHandler::HandleButtonChange(Button* buttons, byte buttonIndex)
+void ChordButtonChangedHandler::HandleButtonChange(ButtonArray& buttons, byte buttonIndex)
 {
   // The following is used to map pin index to MIDI note number.
   const byte LowestNote = MIDI_C - MIDI_OCTAVE;
@@ -48,7 +48,7 @@ void ChordButtonChangedHandler::HandleButtonChange(Button* buttons, byte buttonI
   // Convert button index to MIDI note number.
   byte noteNum = LowestNote + buttonIndex;
 
-  SendMidiNoteCommand(noteNum, buttons[buttonIndex].buttonState.active, mMidiChannel, "ChordButtonChangedHandler");
+  SendMidiNoteCommand(noteNum, buttons.IsActive(buttonIndex), mMidiChannel, "ChordButtonChangedHandler");
 }
 
 #endif // BUILD_RIGHT_HAND_MASTER
\ No newline at end of file
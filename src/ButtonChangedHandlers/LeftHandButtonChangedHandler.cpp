@@ -30,26 +30,52 @@
 
 #include "../SharedMacros.h"
 
+#include "../SetupManagers/LeftHandSetupManager.h"
+
 // Global File Variables
 extern uint16_t gBassButtonFlags;
 extern uint16_t gChordButtonFlags;
 extern uint16_t gToneButtonFlags;
 
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+extern LeftHandButtonEventQueue gLeftHandButtonEventQueue;
+extern volatile bool gIsLeftHandSnapshotRequired;
+#endif
+
 // This class handles Left Hand Arduino button changes. 
-// It sets bits in flags that are subsequently sent to the Right Hand Arduino when requested by the RH Arduino over I2C.
+// It sets bits in flags that are subsequently sent to the Right Hand Arduino when requested by the RH Arduino over I2C,
+// or, with ENABLE_UART_LINK, as soon as they change.
 // This class does not send MIDI.
 LeftHandButtonChangedHandler::LeftHandButtonChangedHandler() : ButtonChangedHandlerBase()
 {
 }
 
 // This function is called each time through the main loop.
-// It packs the note on/off state into the bytes that are sent back to the Master in LeftHandSetupManager::OnDataRequestedByMaster().
+// It packs the note on/off state into the bytes that LeftHandSetupManager::PublishSnapshot() publishes for the Master.
 // Bass Button Indexes:   00-11
 // Chords Button Indexes: 12-23
 // Toggle Button Indexes: 24-37
-void LeftHandButtonChangedHandler::HandleButtonChange(Button* button, byte buttonIndex)
+void LeftHandButtonChangedHandler::HandleButtonChange(ButtonArray& buttons, byte buttonIndex)
 {   
-  SetButtonFlagState(button[buttonIndex].buttonState.active, buttonIndex);
+  SetButtonFlagState(buttons.IsActive(buttonIndex), buttonIndex);
+  LeftHandSetupManager::PublishSnapshot();
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+  // Queue the change for the RH Arduino, after the flags are updated, so that a snapshot taken meanwhile already includes it.
+  uint8_t buttonEvent = buttonIndex | (buttons.IsActive(buttonIndex) ? LeftHandButtonEventActiveFlag : 0);
+#ifdef ENABLE_UART_LINK
+  LeftHandSetupManager::SendButtonEventFrame(buttonEvent);
+#else
+  if (!gLeftHandButtonEventQueue.Push(buttonEvent))
+  {
+    gIsLeftHandSnapshotRequired = true;
+  }
+#endif // ENABLE_UART_LINK
+#endif
+
+#ifdef ENABLE_LH_DATA_READY_LINE
+  LeftHandSetupManager::SetDataReady();
+#endif
 }
 
 void LeftHandButtonChangedHandler::SetButtonFlagState(bool isActive, byte buttonIndex)
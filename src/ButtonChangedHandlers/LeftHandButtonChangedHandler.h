@@ -41,7 +41,7 @@ class LeftHandButtonChangedHandler : public ButtonChangedHandlerBase
 public:
   LeftHandButtonChangedHandler();
 
-  virtual void HandleButtonChange(Button* button, byte buttonIndex);
+  virtual void HandleButtonChange(ButtonArray& buttons, byte buttonIndex);
 
 protected: 
   void SetButtonFlagState(bool isActive, byte buttonIndex);
@@ -54,11 +54,11 @@ MelodyButtonChangedHandler::MelodyButtonChangedHandler() : NoteButtonChangedHand
   mMidiChannel = RightHandLayer1ZeroBasedMidiChannel;
 }
 
-void MelodyButtonChangedHandler::HandleButtonChange(Button* buttons, byte buttonIndex)
+void MelodyButtonChangedHandler::HandleButtonChange(ButtonArray& buttons, byte buttonIndex)
 {
-  bool isKeyDown = buttons[buttonIndex].buttonState.active;
+  bool isKeyDown = buttons.IsActive(buttonIndex);
 
-  // DBG_PRINT_LN("MelodyButtonChangedHandler::HandleButtonChange() - buttons["+String(buttonIndex)+"] @ Pin "+String(buttons[buttonIndex].buttonState.pin)+"= "+String(buttons[buttonIndex].buttonState.active)+".");
+  // DBG_PRINT_LN("MelodyButtonChangedHandler::HandleButtonChange() - buttons["+String(buttonIndex)+"] @ Pin "+String(buttons.GetPin(buttonIndex))+"= "+String(buttons.IsActive(buttonIndex))+".");
 
   // Convert button index to MIDI note number.
   byte noteNum = LowestNote + buttonIndex;
@@ -75,7 +75,7 @@ void MelodyButtonChangedHandler::HandleButtonChange(Button* buttons, byte button
       // Change program upon KeyDown, otherwise ignore.
       if (isKeyDown)
       {
-        bool isOtherKeyDown = buttons[ButtonIndexForIncrementProgramNumber].buttonState.active;
+        bool isOtherKeyDown = buttons.IsActive(ButtonIndexForIncrementProgramNumber);
         if (isOtherKeyDown)
         {
           gProgramChangeManager.ResetProgramNumber();
@@ -96,7 +96,7 @@ void MelodyButtonChangedHandler::HandleButtonChange(Button* buttons, byte button
       // Change program upon KeyDown, otherwise ignore.
       if (isKeyDown)
       {
-        bool isOtherKeyDown = buttons[ButtonIndexForDecrementProgramNumber].buttonState.active;
+        bool isOtherKeyDown = buttons.IsActive(ButtonIndexForDecrementProgramNumber);
         if (isOtherKeyDown)
         {
           gProgramChangeManager.ResetProgramNumber();
@@ -61,9 +61,11 @@ void NoteButtonChangedHandler::SendMidiNoteCommand(byte noteNum, bool isActive,
 #endif
    }
   else {
-    // Button is released; send Note On.
-#ifdef SEND_MIDI
-    midi_note_off(channelZeroBased, noteNum, DefaultVelocity);
+    // Button is released; send Note Off.
+#if defined(SEND_MIDI) && defined(ENABLE_NOTE_OFF_AS_VELOCITY_ZERO)
+    SendMidiNoteRelease(noteNum, channelZeroBased, true);
+#elif defined(SEND_MIDI)
+    SendMidiNoteRelease(noteNum, channelZeroBased, false);
 #else
     DBG_PRINT_LN(" - MIDI Note Off: 0x" + String(noteNum, HEX));
 #endif
@@ -72,4 +74,16 @@ void NoteButtonChangedHandler::SendMidiNoteCommand(byte noteNum, bool isActive,
     gStatusManager.OnMidiEvent(MidiEventType::NoteOff, noteNum, channelZeroBased);
 #endif
   }
-}
\ No newline at end of file
+}
+
+void NoteButtonChangedHandler::SendMidiNoteRelease(byte noteNum, byte channelZeroBased, bool isNoteOffAsVelocityZero)
+{
+  if (isNoteOffAsVelocityZero)
+  {
+    midi_note_on(channelZeroBased, noteNum, 0);
+  }
+  else
+  {
+    midi_note_off(channelZeroBased, noteNum, DefaultVelocity);
+  }
+}
@@ -40,6 +40,9 @@ class NoteButtonChangedHandler : public ButtonChangedHandlerBase
 public:
   NoteButtonChangedHandler();
 
+  // Sends a note release; as Note On with velocity 0 if isNoteOffAsVelocityZero, see ENABLE_NOTE_OFF_AS_VELOCITY_ZERO, otherwise as Note Off.
+  static void SendMidiNoteRelease(byte noteNum, byte channelZeroBased, bool isNoteOffAsVelocityZero);
+
 protected:
   void SendMidiNoteCommand(byte noteNum, bool isActive, byte channelZeroBased, String FileName);
 
@@ -37,7 +37,7 @@
 
 extern ProgramChangeManager gProgramChangeManager; // TODO: Inject dependency.
 
-// Indexes into Button rightHandButtons[NumRightHandButtons], in main.cpp.
+// Indexes into rightHandButtons, in main.cpp.
 const byte ButtonIndexForDecrementProgramNumber = 41;
 const byte ButtonIndexForIncrementProgramNumber = 42;
 
@@ -47,15 +47,15 @@ ProgramChangeButtonChangedHandler::ProgramChangeButtonChangedHandler()
 {
 }
 
-void ProgramChangeButtonChangedHandler::HandleButtonChange(Button* buttons, byte buttonIndex)
+void ProgramChangeButtonChangedHandler::HandleButtonChange(ButtonArray& buttons, byte buttonIndex)
 {
 #ifndef ENABLE_CUSTOM_PROGRAM_CHANGE_BUTTONS
   return;
 #endif
 
-  bool isButtonDown = buttons[buttonIndex].buttonState.active;
+  bool isButtonDown = buttons.IsActive(buttonIndex);
 
-  // DBG_PRINT_LN("ProgramChangeButtonChangedHandler::HandleButtonChange() - buttons["+String(buttonIndex)+"] @ Pin "+String(buttons[buttonIndex].buttonState.pin)+"= "+String(buttons[buttonIndex].buttonState.active)+".");
+  // DBG_PRINT_LN("ProgramChangeButtonChangedHandler::HandleButtonChange() - buttons["+String(buttonIndex)+"] @ Pin "+String(buttons.GetPin(buttonIndex))+"= "+String(buttons.IsActive(buttonIndex))+".");
 
   uint8_t zeroBasedMidiChannelForProgramChange = gProgramChangeManager.GetHighestEnabledLayersChannel();
 
@@ -65,7 +65,7 @@ void ProgramChangeButtonChangedHandler::HandleButtonChange(Button* buttons, byte
     // Change program upon Button Down, otherwise ignore.
     if (isButtonDown)
     {
-      bool isOtherKeyDown = buttons[ButtonIndexForIncrementProgramNumber].buttonState.active;
+      bool isOtherKeyDown = buttons.IsActive(ButtonIndexForIncrementProgramNumber);
       if (isOtherKeyDown)
       {
         gProgramChangeManager.ResetProgramNumber();
@@ -86,7 +86,7 @@ void ProgramChangeButtonChangedHandler::HandleButtonChange(Button* buttons, byte
     // Change program upon KeyDown, otherwise ignore.
     if (isButtonDown)
     {
-      bool isOtherKeyDown = buttons[ButtonIndexForDecrementProgramNumber].buttonState.active;
+      bool isOtherKeyDown = buttons.IsActive(ButtonIndexForDecrementProgramNumber);
       if (isOtherKeyDown)
       {
         gProgramChangeManager.ResetProgramNumber();
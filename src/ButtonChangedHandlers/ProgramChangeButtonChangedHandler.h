@@ -42,7 +42,7 @@ class ProgramChangeButtonChangedHandler : public ButtonChangedHandlerBase
 public:
   ProgramChangeButtonChangedHandler();
 
-  virtual void HandleButtonChange(Button* button, byte buttonIndex);
+  virtual void HandleButtonChange(ButtonArray& buttons, byte buttonIndex);
 };
 
 #endif // BUILD_RIGHT_HAND_MASTER
@@ -42,15 +42,13 @@ ToneButtonChangedHandler::ToneButtonChangedHandler() : ButtonChangedHandlerBase(
 
 // This method is called when the button state changes.
 // Toggle Switches 0-13 correspond to buttonIndex 25-38, Arduino Mega Pins 46, 47, 48, 49, 50, 51, 52, 2, 3, 4, 5, 8, 9, 10.
-void ToneButtonChangedHandler::HandleButtonChange(Button* buttons, byte buttonIndex)
+void ToneButtonChangedHandler::HandleButtonChange(ButtonArray& buttons, byte buttonIndex)
 {
-  ButtonState buttonState = buttons[buttonIndex].buttonState;
-
   // DbgPrintLn("ToneButtonChangedHandler::HandleButtonChange() - " + GetButtonInfo(buttons, buttonIndex));
 
   // Update ToneButtonManager button states.
   int toneButtonIndex = buttonIndex - 24; // TODO: Magic number; 24 is the first Tone Switch buttonIndex.
-  gToneButtonManager.SetIsActive(toneButtonIndex, buttonState.active);
+  gToneButtonManager.SetIsActive(toneButtonIndex, buttons.IsActive(buttonIndex));
 }
 
 #endif // BUILD_RIGHT_HAND_MASTER
\ No newline at end of file
@@ -0,0 +1,46 @@
+/*******************************************************************************
+  ButtonEvent.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+
+#ifndef ButtonEvent_H
+#define ButtonEvent_H
+
+#include <Arduino.h>
+
+#include "SharedConstants.h"
+
+// The ButtonEvent structure describes one button state change: which button changed, to which state, and when.
+// timeMicroseconds is the micros() time the change was sampled, so that the latency to e.g. the MIDI message can be measured.
+// For buttons read by loop(), including the LH buttons received over I2C, it is the time the ScanFrame was started.
+typedef struct
+{
+  unsigned long timeMicroseconds;
+  ButtonBank bank;
+  uint8_t buttonIndex; // Index into the Button array of the hand.
+  bool isActive;
+} ButtonEvent;
+
+#endif
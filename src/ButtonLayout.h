@@ -0,0 +1,270 @@
+/*******************************************************************************
+  ButtonLayout.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef ButtonLayout_H
+#define ButtonLayout_H
+
+#include <Arduino.h>
+
+#include "SharedConstants.h"
+
+// This file contains the button pin map for both Arduinos; it is the only place the button pins are listed.
+// The port, bit mask and bank of each button are resolved at compile time from the pin map, so that the
+// button scan reads AVR port input registers directly, without runtime table lookups.
+// The pin map is also passed to the ButtonArrays in main.cpp, whose pins the Setup Managers set to INPUT_PULLUP.
+
+// Right Hand Button pins, by button index.
+constexpr uint8_t RightHandButtonPins[NumRightHandButtons] = {
+  // Notes 01-12
+  22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33,
+
+  // Notes 13-24
+  34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45,
+
+  // Notes 25-32
+  46, 47, 48, 49, 50, 51, 52, 53,
+
+  // Notes 33-41
+  2, 3, 4, 5, 6, 7, 8, 9, 10,
+
+  // Custom Buttons; Decrement and Increment Program Number.
+  11, 12
+  };
+
+// Left Hand Button pins, by button index.
+constexpr uint8_t LeftHandButtonPins[NumLeftHandButtons] = {
+  // Note Indexes 00-11 (Bass)
+  22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33,
+
+  // Note Indexes 12-23 (Chords)
+  34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45,
+
+  // Toggle Switches Indexes 24-37
+  46, 47, 48, 49, 50, 51, 52, 2, 3, 4, 5, 6, 7, 8
+  };
+
+// --- ATmega2560 (Arduino Mega) pin map.
+
+// AVR I/O ports of the ATmega2560. There is no Port I.
+enum MegaPort : uint8_t
+{
+  PortA, PortB, PortC, PortD, PortE, PortF, PortG, PortH, PortJ, PortK, PortL,
+  NumMegaPorts
+};
+
+const uint8_t NumMegaPins = 70;
+
+// Port of each Arduino Mega pin; same as digital_pin_to_port_PGM in the Arduino core.
+constexpr MegaPort MegaPinPorts[NumMegaPins] = {
+  PortE, PortE, PortE, PortE, PortG, PortE, PortH, PortH, PortH, PortH, // 00-09
+  PortB, PortB, PortB, PortB, PortJ, PortJ, PortH, PortH, PortD, PortD, // 10-19
+  PortD, PortD, PortA, PortA, PortA, PortA, PortA, PortA, PortA, PortA, // 20-29
+  PortC, PortC, PortC, PortC, PortC, PortC, PortC, PortC, PortD, PortG, // 30-39
+  PortG, PortG, PortL, PortL, PortL, PortL, PortL, PortL, PortL, PortL, // 40-49
+  PortB, PortB, PortB, PortB, PortF, PortF, PortF, PortF, PortF, PortF, // 50-59
+  PortF, PortF, PortK, PortK, PortK, PortK, PortK, PortK, PortK, PortK  // 60-69
+  };
+
+// Port bit of each Arduino Mega pin; same as digital_pin_to_bit_mask_PGM in the Arduino core.
+constexpr uint8_t MegaPinBits[NumMegaPins] = {
+  0, 1, 4, 5, 5, 3, 3, 4, 5, 6, // 00-09
+  4, 5, 6, 7, 1, 0, 1, 0, 3, 2, // 10-19
+  1, 0, 0, 1, 2, 3, 4, 5, 6, 7, // 20-29
+  7, 6, 5, 4, 3, 2, 1, 0, 7, 2, // 30-39
+  1, 0, 7, 6, 5, 4, 3, 2, 1, 0, // 40-49
+  3, 2, 1, 0, 0, 1, 2, 3, 4, 5, // 50-59
+  6, 7, 0, 1, 2, 3, 4, 5, 6, 7  // 60-69
+  };
+
+constexpr MegaPort GetMegaPinPort(uint8_t pin) { return MegaPinPorts[pin]; }
+constexpr uint8_t GetMegaPinBitMask(uint8_t pin) { return 1 << MegaPinBits[pin]; }
+
+// Returns the value of the port input register; specialized for each port, so that the read compiles to a single instruction.
+template <uint8_t Port> inline uint8_t ReadPortInputRegister();
+template <> inline uint8_t ReadPortInputRegister<PortA>() { return PINA; }
+template <> inline uint8_t ReadPortInputRegister<PortB>() { return PINB; }
+template <> inline uint8_t ReadPortInputRegister<PortC>() { return PINC; }
+template <> inline uint8_t ReadPortInputRegister<PortD>() { return PIND; }
+template <> inline uint8_t ReadPortInputRegister<PortE>() { return PINE; }
+template <> inline uint8_t ReadPortInputRegister<PortF>() { return PINF; }
+template <> inline uint8_t ReadPortInputRegister<PortG>() { return PING; }
+template <> inline uint8_t ReadPortInputRegister<PortH>() { return PINH; }
+template <> inline uint8_t ReadPortInputRegister<PortJ>() { return PINJ; }
+template <> inline uint8_t ReadPortInputRegister<PortK>() { return PINK; }
+template <> inline uint8_t ReadPortInputRegister<PortL>() { return PINL; }
+
+// --- Button layouts.
+
+constexpr uint8_t GetBankFirstButtonIndex(ButtonBank bank)
+{
+  return bank == RightHandKeys ? FirstRightHandKeyIndex :
+         bank == RightHandCustomButtons ? FirstRightHandCustomButtonIndex :
+         bank == LeftHandBassButtons ? FirstBassButtonIndex :
+         bank == LeftHandChordButtons ? FirstChordButtonIndex :
+         FirstToneSwitchIndex;
+}
+
+constexpr uint8_t GetBankNumButtons(ButtonBank bank)
+{
+  return bank == RightHandKeys ? NumRightHandKeys :
+         bank == RightHandCustomButtons ? NumRightHandCustomButtons :
+         bank == LeftHandBassButtons ? NumBassButtons :
+         bank == LeftHandChordButtons ? NumChordButtons :
+         NumToneSwitches;
+}
+
+// Returns the most buttons in any of the banks from the bank passed in, to the last bank.
+constexpr uint8_t GetMaxBankNumButtons(uint8_t bank)
+{
+  return bank >= NumButtonBanks ? 0 :
+         GetBankNumButtons((ButtonBank)bank) > GetMaxBankNumButtons(bank + 1) ? GetBankNumButtons((ButtonBank)bank) : GetMaxBankNumButtons(bank + 1);
+}
+
+// Layout of the Right Hand Arduino buttons.
+struct RightHandButtonLayout
+{
+  static constexpr uint8_t NumButtons = NumRightHandButtons;
+
+  static constexpr uint8_t GetPin(uint8_t buttonIndex) { return RightHandButtonPins[buttonIndex]; }
+
+  static constexpr ButtonBank GetBank(uint8_t buttonIndex)
+  {
+    return buttonIndex < FirstRightHandCustomButtonIndex ? RightHandKeys : RightHandCustomButtons;
+  }
+};
+
+// Layout of the Left Hand Arduino buttons.
+struct LeftHandButtonLayout
+{
+  static constexpr uint8_t NumButtons = NumLeftHandButtons;
+
+  static constexpr uint8_t GetPin(uint8_t buttonIndex) { return LeftHandButtonPins[buttonIndex]; }
+
+  static constexpr ButtonBank GetBank(uint8_t buttonIndex)
+  {
+    return buttonIndex < FirstChordButtonIndex ? LeftHandBassButtons :
+           buttonIndex < FirstToneSwitchIndex ? LeftHandChordButtons :
+           LeftHandToneSwitches;
+  }
+};
+
+// This structure describes the button at ButtonIndex of the ButtonLayout; all members are compile-time constants.
+template <class ButtonLayout, uint8_t ButtonIndex>
+struct ButtonDescriptor
+{
+  static_assert(ButtonIndex < ButtonLayout::NumButtons, "Button index is outside of the button layout.");
+
+  static constexpr uint8_t Pin = ButtonLayout::GetPin(ButtonIndex);
+  static_assert(Pin < NumMegaPins, "Button pin is not an Arduino Mega pin.");
+
+  static constexpr MegaPort Port = GetMegaPinPort(Pin);
+  static constexpr uint8_t BitMask = GetMegaPinBitMask(Pin);
+  static constexpr ButtonBank Bank = ButtonLayout::GetBank(ButtonIndex);
+};
+
+// This structure reads the pressed state of NumButtons buttons, starting at ButtonIndex, from a snapshot of the port input registers.
+// Bit n of the pressed button bytes corresponds to button index n. The recursion is resolved at compile time.
+template <class ButtonLayout, uint8_t ButtonIndex, uint8_t NumButtons>
+struct ButtonGather
+{
+  static const uint8_t NumFirstHalfButtons = NumButtons / 2;
+
+  static inline void Gather(const uint8_t (&portValues)[NumMegaPorts], uint8_t (&pressedButtonBytes)[8])
+  {
+    ButtonGather<ButtonLayout, ButtonIndex, NumFirstHalfButtons>::Gather(portValues, pressedButtonBytes);
+    ButtonGather<ButtonLayout, ButtonIndex + NumFirstHalfButtons, NumButtons - NumFirstHalfButtons>::Gather(portValues, pressedButtonBytes);
+  }
+};
+
+template <class ButtonLayout, uint8_t ButtonIndex>
+struct ButtonGather<ButtonLayout, ButtonIndex, 1>
+{
+  typedef ButtonDescriptor<ButtonLayout, ButtonIndex> Descriptor;
+
+  static inline void Gather(const uint8_t (&portValues)[NumMegaPorts], uint8_t (&pressedButtonBytes)[8])
+  {
+    // Note: Input pins are pulled high; therefore logic is inverted.
+    if ((portValues[Descriptor::Port] & Descriptor::BitMask) == 0)
+    {
+      pressedButtonBytes[ButtonIndex / 8] |= 1 << (ButtonIndex % 8);
+    }
+  }
+};
+
+// This structure returns the set of ports used by NumButtons buttons, starting at ButtonIndex, as a bit mask of MegaPort values.
+template <class ButtonLayout, uint8_t ButtonIndex, uint8_t NumButtons>
+struct ButtonPortMask
+{
+  static constexpr uint16_t Value = ButtonPortMask<ButtonLayout, ButtonIndex, NumButtons / 2>::Value |
+                                    ButtonPortMask<ButtonLayout, ButtonIndex + NumButtons / 2, NumButtons - NumButtons / 2>::Value;
+};
+
+template <class ButtonLayout, uint8_t ButtonIndex>
+struct ButtonPortMask<ButtonLayout, ButtonIndex, 1>
+{
+  static constexpr uint16_t Value = 1 << ButtonDescriptor<ButtonLayout, ButtonIndex>::Port;
+};
+
+// This structure returns the bit mask of the pins of Port used by NumButtons buttons, starting at ButtonIndex.
+template <class ButtonLayout, uint8_t ButtonIndex, uint8_t NumButtons, MegaPort Port>
+struct ButtonPortBitMask
+{
+  static constexpr uint8_t Value = ButtonPortBitMask<ButtonLayout, ButtonIndex, NumButtons / 2, Port>::Value |
+                                   ButtonPortBitMask<ButtonLayout, ButtonIndex + NumButtons / 2, NumButtons - NumButtons / 2, Port>::Value;
+};
+
+template <class ButtonLayout, uint8_t ButtonIndex, MegaPort Port>
+struct ButtonPortBitMask<ButtonLayout, ButtonIndex, 1, Port>
+{
+  typedef ButtonDescriptor<ButtonLayout, ButtonIndex> Descriptor;
+
+  static constexpr uint8_t Value = Descriptor::Port == Port ? Descriptor::BitMask : 0;
+};
+
+// This structure reads the input register of each port in PortMask, once, starting at Port.
+template <uint16_t PortMask, uint8_t Port = 0>
+struct PortCapture
+{
+  static inline void Capture(uint8_t (&portValues)[NumMegaPorts])
+  {
+    if (PortMask & (1 << Port))
+    {
+      portValues[Port] = ReadPortInputRegister<Port>();
+    }
+
+    PortCapture<PortMask, Port + 1>::Capture(portValues);
+  }
+};
+
+template <uint16_t PortMask>
+struct PortCapture<PortMask, NumMegaPorts>
+{
+  static inline void Capture(uint8_t (&portValues)[NumMegaPorts])
+  {
+  }
+};
+
+#endif
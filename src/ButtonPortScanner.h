@@ -0,0 +1,159 @@
+/*******************************************************************************
+  ButtonPortScanner.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef ButtonPortScanner_H
+#define ButtonPortScanner_H
+
+#include <Arduino.h>
+
+#include "Button.h"
+#include "ButtonLayout.h"
+#include "VerticalCounterDebouncer.h"
+
+// This abstract class provides an interface to read the pressed state of a bank of buttons from the AVR port input registers
+// (PINA, PINC, PINL, etc.), in one pass, instead of calling digitalRead() once per button.
+// The pressed buttons are returned as a bitmap, which ButtonsManager compares against the active buttons of the ButtonArray,
+// so that it visits only the buttons whose state changed. Bit n of the bitmaps corresponds to button index n.
+class ButtonPortScanner
+{
+public:
+  ButtonPortScanner(ButtonArray& buttons, ButtonBank bank, uint64_t scannedButtons);
+
+  // Returns the bitmap of the currently pressed buttons of the scanner.
+  virtual uint64_t ReadPressedButtons() = 0;
+
+  ButtonArray& GetButtons() { return mButtons; }
+  ButtonBank GetBank() { return mBank; }
+  DebouncePolicy GetDebouncePolicy() { return mDebouncePolicy; }
+
+  // Returns the bitmap of the buttons read by the scanner.
+  uint64_t GetScannedButtons() { return mScannedButtons; }
+
+  // Sets the debounce time of the buttons; both that of the ButtonArray, and that of the vertical counters.
+  void SetDebounceDelayMs(uint8_t debounceDelayMs)
+  {
+    mButtons.SetDebounceDelayMs(debounceDelayMs);
+    mVerticalCounterDebouncer.SetDebounceDelayMs(debounceDelayMs);
+  }
+
+  // Debounces the pressed buttons passed in, with the bank's vertical counters; returns the bitmap of buttons whose debounced state toggled.
+  uint64_t DebounceButtons(uint64_t pressedButtons, unsigned long curTimeMs)
+  {
+    uint64_t eagerPressButtons = mDebouncePolicy == EagerPressDebounce ? ~(uint64_t)0 : 0;
+    return DebounceButtons(pressedButtons, curTimeMs, eagerPressButtons);
+  }
+
+  // As above, with the bitmap of buttons whose presses are accepted on their first edge passed in.
+  uint64_t DebounceButtons(uint64_t pressedButtons, unsigned long curTimeMs, uint64_t eagerPressButtons)
+  {
+    return mVerticalCounterDebouncer.Update(pressedButtons, curTimeMs, eagerPressButtons);
+  }
+
+  // Returns the bitmap of buttons debounced by DebounceButtons().
+  uint64_t GetDebouncedButtons() { return mVerticalCounterDebouncer.GetDebouncedButtons(); }
+
+protected:
+  // The default constructor is protected to prevent its usage.
+  ButtonPortScanner();
+
+protected:
+  ButtonArray& mButtons;
+  ButtonBank mBank;
+  DebouncePolicy mDebouncePolicy;
+  uint64_t mScannedButtons;
+  VerticalCounterDebouncer<uint64_t> mVerticalCounterDebouncer;
+};
+
+// This class reads the bank of buttons, Bank, of the ButtonLayout.
+// The port, and bit mask, of each button are resolved at compile time from the pin map in ButtonLayout.h;
+// the scan reads each port used by the bank once, and does no runtime table lookups.
+template <class ButtonLayout, ButtonBank Bank>
+class ButtonBankScanner : public ButtonPortScanner
+{
+public:
+  static const uint8_t FirstButtonIndex = GetBankFirstButtonIndex(Bank);
+  static const uint8_t NumButtons = GetBankNumButtons(Bank);
+
+  static_assert(ButtonLayout::GetBank(FirstButtonIndex) == Bank && ButtonLayout::GetBank(FirstButtonIndex + NumButtons - 1) == Bank,
+                "Button bank is not part of the button layout.");
+
+public:
+  ButtonBankScanner(ButtonArray& buttons) : ButtonPortScanner(buttons, Bank, (((uint64_t)1 << NumButtons) - 1) << FirstButtonIndex)
+  {
+  }
+
+  virtual uint64_t ReadPressedButtons()
+  {
+    uint8_t portValues[NumMegaPorts];
+    PortCapture<ButtonPortMask<ButtonLayout, FirstButtonIndex, NumButtons>::Value>::Capture(portValues);
+
+    union
+    {
+      uint64_t bitmap;
+      uint8_t bytes[8];
+    } pressedButtons;
+
+    pressedButtons.bitmap = 0;
+    ButtonGather<ButtonLayout, FirstButtonIndex, NumButtons>::Gather(portValues, pressedButtons.bytes);
+
+    return pressedButtons.bitmap;
+  }
+};
+
+// This class reads all the buttons of the ButtonLayout, in one pass; each port used by the layout is read once.
+// It is used with a table of InputZones, which gives the handler, and debounce policy, of each range of buttons.
+template <class ButtonLayout>
+class ButtonLayoutScanner : public ButtonPortScanner
+{
+public:
+  static const uint8_t NumButtons = ButtonLayout::NumButtons;
+
+  static_assert(NumButtons <= 64, "Button layout has more buttons than the bitmaps have bits.");
+
+public:
+  ButtonLayoutScanner(ButtonArray& buttons) : ButtonPortScanner(buttons, NumButtonBanks, ((((uint64_t)1 << (NumButtons - 1)) << 1) - 1))
+  {
+  }
+
+  virtual uint64_t ReadPressedButtons()
+  {
+    uint8_t portValues[NumMegaPorts];
+    PortCapture<ButtonPortMask<ButtonLayout, 0, NumButtons>::Value>::Capture(portValues);
+
+    union
+    {
+      uint64_t bitmap;
+      uint8_t bytes[8];
+    } pressedButtons;
+
+    pressedButtons.bitmap = 0;
+    ButtonGather<ButtonLayout, 0, NumButtons>::Gather(portValues, pressedButtons.bytes);
+
+    return pressedButtons.bitmap;
+  }
+};
+
+#endif
@@ -27,7 +27,6 @@
 // TODO: Rename to ButtonsAndSensorsManager, or AnalogAndDigitalInputManager.
 
 #include <Arduino.h>
-#include <Wire.h>
 
 #include "MIDIAccordion.h"
 
@@ -41,8 +40,26 @@
 #include "ToneButtonManager.h"
 #endif // BUILD_RIGHT_HAND_MASTER
 
+#ifdef BUILD_RIGHT_HAND_MASTER
+#include "Utilities/I2CTelemetry.h"
+
+extern I2CTelemetry gI2CTelemetry;
+#endif // BUILD_RIGHT_HAND_MASTER
+
+#ifdef BUILD_RIGHT_HAND_MASTER
+#include "LeftHandLink.h"
+
+extern LeftHandLink gLeftHandLink;
+#endif // BUILD_RIGHT_HAND_MASTER
+
 #include "Utilities/Utilities.h"
 
+#ifndef SEND_MIDI
+#include "Utilities/Diagnostics.h"
+
+extern Diagnostics diagnostics;
+#endif
+
 #include "ButtonChangedHandlers/BassButtonChangedHandler.h"
 #include "ButtonChangedHandlers/ChordButtonChangedHandler.h"
 
@@ -50,18 +67,33 @@
 #include "ButtonChangedHandlers/ToneButtonChangedHandler.h"
 #endif // BUILD_RIGHT_HAND_MASTER
 
-extern Button leftHandButtons[NumLeftHandButtons];
-extern Button rightHandButtons[NumRightHandButtons];
-
 #ifdef BUILD_RIGHT_HAND_MASTER
 
 BassButtonChangedHandler bassButtonChangedHandler;
 ChordButtonChangedHandler chordButtonChangedHandler;
 ToneButtonChangedHandler toneButtonChangedHandler;
 
+// The button changed handler of each LH bank, in bank order, from FirstLeftHandButtonBank.
+static ButtonChangedHandlerBase* const LeftHandBankHandlers[NumLeftHandButtonBanks] = {
+  &bassButtonChangedHandler,
+  &chordButtonChangedHandler,
+  &toneButtonChangedHandler
+  };
+
 // TODO: Pass into ToneButtonChangedHandler as dependency?
 ToneButtonManager gToneButtonManager;
 
+#ifdef ENABLE_LH_FRAME_CHECK
+// A snapshot reply is the generation byte, the button flag bytes, and a CRC-8; a ReadLeftHandEvents reply ends with a CRC-8.
+static const uint8_t NumLeftHandSnapshotReplyBytes = NumBytesExpectedFromLeftHandArduino + LeftHandSnapshotCheckNumBytes;
+static const uint8_t NumLeftHandEventsCheckBytes = LeftHandEventsCheckNumBytes;
+static const uint8_t NumLeftHandStatusReplyBytes = NumLeftHandStatusBytes + LeftHandStatusCheckNumBytes;
+#else
+static const uint8_t NumLeftHandSnapshotReplyBytes = NumBytesExpectedFromLeftHandArduino;
+static const uint8_t NumLeftHandEventsCheckBytes = 0;
+static const uint8_t NumLeftHandStatusReplyBytes = NumLeftHandStatusBytes;
+#endif // ENABLE_LH_FRAME_CHECK
+
 #endif // BUILD_RIGHT_HAND_MASTER
 
 #if defined(DEBUG_I2C)
@@ -75,60 +107,294 @@ unsigned long maxTimeBetweenFetchesMicroseconds = 0;
 
 // Used only by RH Arduino to keep track of both LH Arduino and RH Arduino buttons and sensors.
 // It contains utilty functions to update LH buttons given corresponding button flags.
-ButtonsManager::ButtonsManager(Button* leftHandButtons, Button* rightHandButtons, Sensor* leftHandSensors, Sensor* rightHandSensors) :
+ButtonsManager::ButtonsManager(ButtonArray* leftHandButtons, ButtonArray* rightHandButtons, Sensor* leftHandSensors, Sensor* rightHandSensors) :
   mLeftHandButtons(leftHandButtons),
   mRightHandButtons(rightHandButtons),
   mLeftHandSensors(leftHandSensors),
   mRightHandSensors(rightHandSensors)
 {
+#ifdef BUILD_RIGHT_HAND_MASTER
+  for (uint8_t i = 0; i < NumLeftHandButtonBanks; i++)
+  {
+    mLeftHandBanks[i].bank = (ButtonBank)(FirstLeftHandButtonBank + i);
+    mLeftHandBanks[i].buttonChangedHandler = LeftHandBankHandlers[i];
+    mLeftHandBanks[i].newFlags = 0;
+    mLeftHandBanks[i].curFlags = 0;
+  }
+#endif // BUILD_RIGHT_HAND_MASTER
+
+  BeginScanFrame();
 }
 
-// This method reads the digital input pin corresponding the the buttons passed in.
-// If input parameter, debounce, is true, the read occurs only after the debounce time has elapsed.
+// This method starts the ScanFrame of a pass of loop(). It samples the clock once, for all the input paths of the frame.
+// It is called at the start of loop(), before any buttons or sensors are read.
+void ButtonsManager::BeginScanFrame()
+{
+  mScanFrame.timeMs = millis();
+  mScanFrame.timeMicroseconds = micros();
+  mScanFrame.pressedButtons = 0;
+#ifdef BUILD_RIGHT_HAND_MASTER
+  for (uint8_t i = 0; i < NumLeftHandButtonBanks; i++)
+  {
+    mScanFrame.leftHandButtonFlags[i] = mLeftHandBanks[i].newFlags;
+  }
+#endif // BUILD_RIGHT_HAND_MASTER
+  mScanFrame.sensors = NULL;
+  mScanFrame.sensorChangedHandler = NULL;
+  mScanFrame.changedSensors = 0;
+  mScanFrame.numButtonEvents = 0;
+  mScanFrame.totalButtonEvents = 0;
+}
+
+// This method ends the ScanFrame of a pass of loop(), passing the button events not yet dispatched, and then the sensor changes, of the frame to their handlers.
+// It is called at the end of loop(), after all buttons and sensors are read; uncomment LOG_FRAME_TIME() to measure the frame time.
+void ButtonsManager::EndScanFrame()
+{
+  DispatchButtonEvents();
+  DispatchSensorChanges();
+
+  // LOG_FRAME_TIME(mScanFrame);
+}
+
+const ScanFrame& ButtonsManager::GetScanFrame() const
+{
+  return mScanFrame;
+}
+
+// This method reads the digital input pins of the buttons of each InputZone passed in, in one pass over the ButtonArray,
+// and passes each changed button to its zone's button changed handler.
+// If input parameter, debounce, is true, a button state change is accepted per the zone's debounce policy.
+// With SymmetricDebounce, the read occurs only after the debounce time has elapsed.
 // It is used by both the RH and LH Arduinos.
 // Debounce is expected to be performed only on the RH Arduino; LH Arduino continually updates its button state.
-void ButtonsManager::ReadButtons(Button* buttons, int startButtonIndex, int endButtonIndex, ButtonChangedHandlerBase& buttonChangedHandler, bool debounce)
+void ButtonsManager::ReadButtons(ButtonArray& buttons, const InputZone* inputZones, uint8_t numInputZones, bool debounce)
 {
   // DBG_PRINT_LN("ButtonsManager::ReadButtons() - Started.");
+  unsigned long curTimeMs = mScanFrame.timeMs;
+  buttons.ExpireSettledButtons(curTimeMs);
   bool newButtonState = false;
-  for (byte i = startButtonIndex; i <= endButtonIndex; i++)
+  for (uint8_t zoneIndex = 0; zoneIndex < numInputZones; zoneIndex++)
   {
-    if (debounce && !IsButtonDebounced(buttons[i]))
+    const InputZone& inputZone = inputZones[zoneIndex];
+    DebouncePolicy debouncePolicy = inputZone.debouncePolicy;
+    for (byte i = inputZone.firstButtonIndex; i <= inputZone.lastButtonIndex; i++)
     {
-      continue;
+      if (debounce && debouncePolicy == SymmetricDebounce && !IsButtonDebounced(buttons, i, curTimeMs))
+      {
+        continue;
+      }
+
+      // Button has been debounced; OK to read the corresponding pin value.
+      int inputVal = digitalRead(buttons.GetPin(i));
+      // DBG_PRINT_LN("ButtonsManager::ReadButtons() - ["+String(i)+"] @ Pin "+String(buttons.GetPin(i))+"= "+String(inputVal)+".");
+
+      // Note: Input pin is pulled high; therefore logic is inverted.
+      newButtonState = inputVal == 0 ? true : false;
+      if (newButtonState)
+      {
+        mScanFrame.pressedButtons |= ButtonArray::GetButtonMask(i);
+      }
+
+      if (debounce && debouncePolicy == EagerPressDebounce)
+      {
+        if (!IsButtonToggleAccepted(buttons, i, newButtonState, debouncePolicy, curTimeMs))
+        {
+          continue;
+        }
+      }
+      else if (buttons.IsActive(i) == newButtonState) {
+
+        // Button state did not change; check next button.
+        // DBG_PRINT_LN("Button at pin " + String(i) + " is active");
+        continue;
+      }
+
+      // Button state changed. Save its state.
+      buttons.SetActive(i, newButtonState);
+      buttons.StartSettling(i, curTimeMs);
+
+      // DBG_PRINT_LN("ButtonsManager::ReadButtons() - " + GetButtonInfo(buttons, i) + " State changed to = " + String(buttons.IsActive(i))+".");
+
+      ButtonEvent buttonEvent;
+      buttonEvent.timeMicroseconds = mScanFrame.timeMicroseconds;
+      buttonEvent.bank = GetButtonBank(buttons, i);
+      buttonEvent.buttonIndex = i;
+      buttonEvent.isActive = newButtonState;
+      AddButtonEvent(buttons, buttonEvent, *inputZone.buttonChangedHandler);
     }
+  }
+}
+#ifdef ENABLE_PORT_REGISTER_SCAN
+
+// This method reads the buttons of the ButtonPortScanner passed in, reading each port input register once, and updates the
+// buttons of each InputZone passed in. The pressed buttons are compared against the active buttons of the ButtonArray;
+// only buttons whose bit changed are visited, and each is passed straight to its zone's button changed handler.
+// If input parameter, debounce, is true, the buttons are debounced with the ButtonDebounceStrategy, and the zone's DebouncePolicy.
+// With TimeWindowDebounce, a changed button is updated only after the debounce time has elapsed;
+// otherwise its bit remains changed, and it is visited again on the next scan.
+// With EagerPressDebounce, the active buttons are also visited, to cancel releases that are still settling.
+// With VerticalCounterDebounce, all the scanned buttons are debounced at once, and only the toggled buttons are visited.
+void ButtonsManager::ReadButtons(ButtonPortScanner& buttonPortScanner, const InputZone* inputZones, uint8_t numInputZones, bool debounce)
+{
+  uint64_t pressedButtons = buttonPortScanner.ReadPressedButtons();
 
-    // Button has been debounced; OK to read the corresponding pin value.
-    int inputVal = digitalRead(buttons[i].buttonState.pin);
-    // DBG_PRINT_LN("ButtonsManager::ReadButtons() - ["+String(i)+"] @ Pin "+String(buttons[i].buttonState.pin)+"= "+String(inputVal)+".");
+  UpdateZoneButtons(buttonPortScanner, inputZones, numInputZones, pressedButtons, 0, 0, debounce);
+}
+
+// This method reads the bank of buttons of the ButtonPortScanner passed in, like the method above, as a single InputZone
+// with the button changed handler passed in, and the bank's debounce policy.
+void ButtonsManager::ReadButtons(ButtonPortScanner& buttonPortScanner, ButtonChangedHandlerBase& buttonChangedHandler, bool debounce)
+{
+  InputZone inputZone = GetBankInputZone(buttonPortScanner, buttonChangedHandler);
+  uint64_t pressedButtons = buttonPortScanner.ReadPressedButtons();
 
-    // Note: Input pin is pulled high; therefore logic is inverted.
-    newButtonState = inputVal == 0 ? true : false;
+  UpdateZoneButtons(buttonPortScanner, &inputZone, 1, pressedButtons, 0, 0, debounce);
+}
 
-    if (buttons[i].buttonState.active == newButtonState) {
+#ifdef ENABLE_PIN_CHANGE_CAPTURE
 
-      // Button state did not change; check next button.
-      // DBG_PRINT_LN("Button at pin " + String(i) + " is active");
-      continue;
+// This method reads the bank of buttons like the method above, and adds the presses captured by the pin change interrupt since the last scan.
+// A captured press of a button that is already released is handled as if the scan had read it pressed;
+// with EagerPressDebounce, its release then follows after the debounce time, so that short taps are not lost.
+// The events of captured presses are timestamped with the time of the first captured press, instead of the time of the scan.
+void ButtonsManager::ReadButtons(ButtonPortScanner& buttonPortScanner, PinChangeCapture& pinChangeCapture, ButtonChangedHandlerBase& buttonChangedHandler, bool debounce)
+{
+  InputZone inputZone = GetBankInputZone(buttonPortScanner, buttonChangedHandler);
+  uint64_t pressedButtons = buttonPortScanner.ReadPressedButtons();
+
+  unsigned long capturedPressTimeMicroseconds = mScanFrame.timeMicroseconds;
+  uint64_t capturedPresses = pinChangeCapture.ReadCapturedPresses(buttonPortScanner.GetButtons().GetActiveButtons(), capturedPressTimeMicroseconds);
+
+  UpdateZoneButtons(buttonPortScanner, &inputZone, 1, pressedButtons | capturedPresses, capturedPresses, capturedPressTimeMicroseconds, debounce);
+}
+
+#endif // ENABLE_PIN_CHANGE_CAPTURE
+
+// Returns the InputZone of the bank of buttons of the ButtonPortScanner passed in.
+InputZone ButtonsManager::GetBankInputZone(ButtonPortScanner& buttonPortScanner, ButtonChangedHandlerBase& buttonChangedHandler)
+{
+  uint64_t scannedButtons = buttonPortScanner.GetScannedButtons();
+
+  InputZone inputZone;
+  inputZone.firstButtonIndex = __builtin_ctzll(scannedButtons);
+  inputZone.lastButtonIndex = 63 - __builtin_clzll(scannedButtons);
+  inputZone.buttonChangedHandler = &buttonChangedHandler;
+  inputZone.debouncePolicy = buttonPortScanner.GetDebouncePolicy();
+  return inputZone;
+}
+
+// This method updates the buttons of the InputZones passed in, given the pressed buttons read by the ButtonPortScanner passed in.
+// The events of the captured presses passed in are timestamped with the captured press time passed in; the others with the ScanFrame time.
+void ButtonsManager::UpdateZoneButtons(ButtonPortScanner& buttonPortScanner, const InputZone* inputZones, uint8_t numInputZones, uint64_t pressedButtons,
+                                       uint64_t capturedPresses, unsigned long capturedPressTimeMicroseconds, bool debounce)
+{
+  unsigned long curTimeMs = mScanFrame.timeMs;
+  mScanFrame.pressedButtons |= pressedButtons;
+
+  ButtonArray& buttons = buttonPortScanner.GetButtons();
+  buttons.ExpireSettledButtons(curTimeMs);
+
+  bool isVerticalCounterDebounce = debounce && ButtonDebounceStrategy == VerticalCounterDebounce;
+  uint64_t activeButtons = buttons.GetActiveButtons() & buttonPortScanner.GetScannedButtons();
+  uint64_t changedButtons;
+  if (isVerticalCounterDebounce)
+  {
+    uint64_t eagerPressButtons = 0;
+    for (uint8_t zoneIndex = 0; zoneIndex < numInputZones; zoneIndex++)
+    {
+      if (inputZones[zoneIndex].debouncePolicy == EagerPressDebounce)
+      {
+        eagerPressButtons |= GetInputZoneButtons(inputZones[zoneIndex]);
+      }
     }
 
-    // Button state changed. Save its state.
-    buttons[i].buttonState.active = newButtonState;
-    buttons[i].lastToggleTimeMs = millis();
+    changedButtons = buttonPortScanner.DebounceButtons(pressedButtons, curTimeMs, eagerPressButtons);
+  }
+  else
+  {
+    changedButtons = pressedButtons ^ activeButtons;
+  }
+
+  ButtonEvent buttonEvent;
+  for (uint8_t zoneIndex = 0; zoneIndex < numInputZones; zoneIndex++)
+  {
+    const InputZone& inputZone = inputZones[zoneIndex];
+    DebouncePolicy debouncePolicy = inputZone.debouncePolicy;
+    uint64_t zoneButtons = GetInputZoneButtons(inputZone);
 
-    // DBG_PRINT_LN("ButtonsManager::ReadButtons() - " + GetButtonInfo(buttons, i) + " State changed to = " + String(buttons[i].buttonState.active)+".");
+    uint64_t visitButtons = changedButtons & zoneButtons;
+    if (!isVerticalCounterDebounce && debounce && debouncePolicy == EagerPressDebounce)
+    {
+      // Also visit the active buttons, to cancel releases that are still settling.
+      visitButtons |= activeButtons & zoneButtons;
+    }
 
-    buttonChangedHandler.HandleButtonChange(buttons, i);
+    while (visitButtons != 0)
+    {
+      byte i = __builtin_ctzll(visitButtons);
+      uint64_t buttonMask = (uint64_t)1 << i;
+      visitButtons &= ~buttonMask;
+
+      if (isVerticalCounterDebounce)
+      {
+        // The vertical counters already debounced the button.
+        buttons.SetActive(i, (buttonPortScanner.GetDebouncedButtons() & buttonMask) != 0);
+      }
+      else
+      {
+        bool isPressed = (pressedButtons & buttonMask) != 0;
+        if (debounce && !IsButtonToggleAccepted(buttons, i, isPressed, debouncePolicy, curTimeMs))
+        {
+          continue;
+        }
+
+        // Button state changed. Save its state.
+        buttons.SetActive(i, isPressed);
+        buttons.StartSettling(i, curTimeMs);
+      }
+
+      // DBG_PRINT_LN("ButtonsManager::ReadButtons() - " + GetButtonInfo(buttons, i) + " State changed to = " + String(buttons.IsActive(i))+".");
+
+      buttonEvent.timeMicroseconds = (capturedPresses & buttonMask) != 0 ? capturedPressTimeMicroseconds : mScanFrame.timeMicroseconds;
+      buttonEvent.bank = GetButtonBank(buttons, i);
+      buttonEvent.buttonIndex = i;
+      buttonEvent.isActive = buttons.IsActive(i);
+      AddButtonEvent(buttons, buttonEvent, *inputZone.buttonChangedHandler);
+    }
   }
+}
+
+#endif // ENABLE_PORT_REGISTER_SCAN
+
+#ifdef ENABLE_TIMER_KEY_SCAN
+
+// This method drains the button events queued by the timer interrupt of the TimerKeyScanner passed in, in the order they were detected,
+// and adds each to the ScanFrame, for the button changed handler. The events are already debounced, and keep their interrupt timestamps.
+void ButtonsManager::DispatchButtonEvents(TimerKeyScanner& timerKeyScanner, ButtonChangedHandlerBase& buttonChangedHandler)
+{
+  ButtonArray& buttons = timerKeyScanner.GetButtons();
+
+  ButtonEvent buttonEvent;
+  while (timerKeyScanner.PopButtonEvent(buttonEvent))
+  {
+    buttons.SetActive(buttonEvent.buttonIndex, buttonEvent.isActive);
 
+    AddButtonEvent(buttons, buttonEvent, buttonChangedHandler);
+  }
 }
 
+#endif // ENABLE_TIMER_KEY_SCAN
+
 #ifdef BUILD_RIGHT_HAND_MASTER
 
 // This method reads the analog input pin corresponding the the sensors passed in.
+// The changed sensors are recorded in the ScanFrame, and passed to the sensor changed handler by EndScanFrame().
 // It is currently only used by the RH Arduino. If sensors are used in the LH Arduino, remove the ifdef here and the header.
 void ButtonsManager::ReadSensors(Sensor* sensors, int numSensors, SensorChangedHandlerBase& sensorChangedHandler)
 {
+  mScanFrame.sensors = sensors;
+  mScanFrame.sensorChangedHandler = &sensorChangedHandler;
+
   //DBG_PRINT_LN("ButtonsManager::ReadSensors() - Started.");
   byte newSensorValue = 0;
   for (byte i = 0; i < numSensors; i++)
@@ -151,7 +417,7 @@ void ButtonsManager::ReadSensors(Sensor* sensors, int numSensors, SensorChangedH
 
     // DBG_PRINT_LN("ButtonsManager::ReadSensors() - " + GetSensorInfo(sensors, i) + " State changed to = " + String(sensors[i].sensorState.value) + ".");
 
-    sensorChangedHandler.HandleSensorChange(sensors, i);
+    mScanFrame.changedSensors |= 1 << i;
   }
 }
 
@@ -161,17 +427,71 @@ void ButtonsManager::ReadSensors(Sensor* sensors, int numSensors, SensorChangedH
 
 // The following methods are only used by the RH Arduino.
 
-// Get LH Arduino button states via I2C.
-// This method sends an I2C Request to the LH Arduino and then reads a byte at a time from the Wire object.
+// Get LH Arduino button states via gLeftHandLink; I2C, or UART (ENABLE_UART_LINK).
+// Each call picks up the reply of the request in progress, if any, and starts the next request when due.
+// Without ENABLE_ASYNC_I2C, the Wire library completes each request before StartLeftHandRequest() returns, so the reply is handled in the same call.
+// With ENABLE_ASYNC_I2C, the TwiMaster moves the bytes from its interrupt, and the reply is handled by a later call;
+// loop() does not wait for the I2C bus. See I2CLeftHandLink, and UartLeftHandLink.
 void ButtonsManager::FetchLeftHandArduinoButtons()
 {
 #ifdef DISABLE_I2C
   return;
 #endif // DISABLE_I2C
 
+  if (mLeftHandFetchState == LeftHandFetchIdle)
+  {
+    // Read the status now and then, to detect a LH Arduino restart.
+    if (mScanFrame.timeMs - mLastLeftHandStatusPollTimeMs >= LeftHandStatusPollIntervalMs)
+    {
+      mLastLeftHandStatusPollTimeMs = mScanFrame.timeMs;
+      mPendingLeftHandCommands |= LeftHandStatusPending;
+    }
+
+    // Queued commands delay the next fetch by a request each.
+    if (mPendingLeftHandCommands != 0)
+    {
+      StartLeftHandCommand();
+    }
+#ifdef ENABLE_LH_DATA_READY_LINE
+    else if (IsLeftHandFetchDue())
+#else
+    else
+#endif // ENABLE_LH_DATA_READY_LINE
+    {
+      StartLeftHandFetch();
+    }
+  }
+
+  // With the delta protocol, a reply may start the next request; handle each reply that is ready.
+  const uint8_t* replyBytes;
+  uint8_t numReplyBytes;
+  while (mLeftHandFetchState != LeftHandFetchIdle && PollLeftHandRequest(replyBytes, numReplyBytes))
+  {
+    bool isCommand = mLeftHandFetchState >= LeftHandSendingCommand;
+    HandleLeftHandReply(replyBytes, numReplyBytes);
+
+    // The fetch is complete once a reply starts no further request.
+    if (mLeftHandFetchState == LeftHandFetchIdle && !isCommand)
+    {
+      gI2CTelemetry.LogFetch(micros() - mLeftHandFetchStartTimeMicroseconds);
+    }
+  }
+
+  // Let the LH button states settle, even if no reply was received. While the button flags are unchanged, and settled, there is nothing to update.
+  if (!IsLeftHandSettled())
+  {
+    UpdateLeftHandButtonStates();
+  }
+}
+
+// Starts the first request of a fetch; a snapshot of the button flags, or, with the delta protocol, the number of button events.
+void ButtonsManager::StartLeftHandFetch()
+{
+  mLeftHandFetchStartTimeMicroseconds = micros();
+
 #ifdef DEBUG_I2C
   // DBG_PRINT_LN();
-  // DBG_PRINT_LN("ButtonsManager::FetchLeftHandArduinoButtons() - Sending I2C request to slave.");
+  // DBG_PRINT_LN("ButtonsManager::StartLeftHandFetch() - Sending I2C request to slave.");
 
   unsigned long startTimeMicroseconds = micros();
   unsigned long intervalBetweenFetchesMicroseconds = 0;
@@ -187,63 +507,350 @@ void ButtonsManager::FetchLeftHandArduinoButtons()
   }
 #endif // DEBUG_I2C
 
-  // Request LH button states from LH (slave) Arduino via I2C.
-  // DBG_PRINT_LN("ButtonsManager::FetchLeftHandArduinoButtons - Master requesting " + String(NumBytesExpectedFromLeftHandArduino) + " bytes from Slave1");
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+  if (!mIsLeftHandSnapshotRequired)
+  {
+    StartLeftHandRequest(LeftHandFetchingEventCount, ReadLeftHandEventCount, 1);
+    return;
+  }
 
-  // NOTE: Slave must be connected to Master SDA and SCL lines, otherwise Master will freeze.
+  StartLeftHandRequest(LeftHandFetchingSnapshot, ReadLeftHandSnapshot, NumLeftHandSnapshotReplyBytes);
+#else
   // Request 6 bytes from LH Arduino; 2 for Bass, 2 for Chords, 2 for Tone Switches.
   // These contain the flags representing the button/switch states.
-  Wire.requestFrom((uint8_t)LeftHandI2CDeviceId, (uint8_t)NumBytesExpectedFromLeftHandArduino);    // Request 6 bytes from slave device.
+  StartLeftHandRequest(LeftHandFetchingSnapshot, 0, NumLeftHandSnapshotReplyBytes);
+#endif // ENABLE_I2C_DELTA_PROTOCOL
+}
 
-  // DBG_PRINT("Master receiving from slave: ");
+// Starts the first of the queued commands to the LH Arduino. A command that could not be started stays queued.
+void ButtonsManager::StartLeftHandCommand()
+{
+  uint8_t pendingCommand = mPendingLeftHandCommands & -mPendingLeftHandCommands;
+  uint8_t commandBytes[MaxLeftHandCommandBytes];
+  uint8_t numCommandBytes = 0;
+  LeftHandFetchState fetchState = LeftHandSendingCommand;
+  uint8_t numReplyBytes = 0;
 
-  int numBytesAvailable;
-  int numBytesReceived = 0;
+  switch (pendingCommand)
+  {
+    case LeftHandScanIntervalPending:
+      commandBytes[numCommandBytes++] = SetLeftHandScanInterval;
+      commandBytes[numCommandBytes++] = lowByte(mLeftHandScanIntervalMicroseconds);
+      commandBytes[numCommandBytes++] = highByte(mLeftHandScanIntervalMicroseconds);
+      break;
 
-  while ((numBytesAvailable = Wire.available()) != 0) { // slave may send less than requested
+    case LeftHandDebounceDelayPending:
+      commandBytes[numCommandBytes++] = SetLeftHandDebounceDelay;
+      commandBytes[numCommandBytes++] = mLeftHandDebounceDelayMs;
+      break;
 
-    uint8_t receivedByte = Wire.read(); // receive a byte as character
+    case LeftHandSnapshotPending:
+      commandBytes[numCommandBytes++] = RequestLeftHandSnapshot;
+      break;
 
-    UpdateNewButtonFlags(receivedByte, numBytesReceived);
+    default:
+      // LeftHandStatusPending.
+      commandBytes[numCommandBytes++] = ReadLeftHandStatus;
+      fetchState = LeftHandFetchingStatus;
+      numReplyBytes = NumLeftHandStatusReplyBytes;
+      break;
+  }
 
-    numBytesReceived++;
+  StartLeftHandRequest(fetchState, commandBytes, numCommandBytes, numReplyBytes);
 
-    // DBG_PRINT(String(receivedByte, HEX));
-    // DBG_PRINT(" ");
+  if (mLeftHandFetchState != LeftHandFetchIdle)
+  {
+    mPendingLeftHandCommands &= ~pendingCommand;
+    mLeftHandCommandInProgress = pendingCommand;
   }
+}
 
-  // Verify expected number of bytes received.
-  if (numBytesReceived != NumBytesExpectedFromLeftHandArduino)
+// Sets the scan interval of the LH Arduino; 0 scans as often as its loop() runs.
+void ButtonsManager::SetLeftHandScanIntervalMicroseconds(uint16_t scanIntervalMicroseconds)
+{
+  mLeftHandScanIntervalMicroseconds = scanIntervalMicroseconds;
+  mPendingLeftHandCommands |= LeftHandScanIntervalPending;
+}
+
+// Sets the debounce delay of the LH Arduino; used only if it debounces, see ENABLE_LH_SLAVE_DEBOUNCE.
+void ButtonsManager::SetLeftHandDebounceDelayMs(uint8_t debounceDelayMs)
+{
+  mLeftHandDebounceDelayMs = debounceDelayMs;
+  mPendingLeftHandCommands |= LeftHandDebounceDelayPending;
+}
+
+// Sends the configuration to the LH Arduino again, in case it restarted, and has it publish its button flags; the next fetch reads them.
+void ButtonsManager::RequestLeftHandResync()
+{
+  mPendingLeftHandCommands |= LeftHandScanIntervalPending | LeftHandDebounceDelayPending | LeftHandSnapshotPending;
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+  mIsLeftHandSnapshotRequired = true;
+#endif
+
+#ifdef ENABLE_LH_FRAME_CHECK
+  // Apply the next snapshot, even if its generation is unchanged.
+  mIsLeftHandGenerationValid = false;
+#endif
+}
+
+// Reads the status of the LH Arduino; it is reported by gI2CTelemetry once received.
+void ButtonsManager::RequestLeftHandStatus()
+{
+  mIsLeftHandStatusReportRequested = true;
+  mPendingLeftHandCommands |= LeftHandStatusPending;
+}
+
+// Starts a request to the LH Arduino over gLeftHandLink, of the number of bytes passed in. If command is not 0, it is sent first.
+// The fetch state passed in tells HandleLeftHandReply() how to handle the reply.
+void ButtonsManager::StartLeftHandRequest(LeftHandFetchState fetchState, uint8_t command, uint8_t numBytes)
+{
+  StartLeftHandRequest(fetchState, &command, command != 0 ? 1 : 0, numBytes);
+}
+
+void ButtonsManager::StartLeftHandRequest(LeftHandFetchState fetchState, const uint8_t* commandBytes, uint8_t numCommandBytes, uint8_t numBytes)
+{
+  mLeftHandFetchState = fetchState;
+  mNumLeftHandBytesRequested = numBytes;
+
+  if (!gLeftHandLink.StartRequest(commandBytes, numCommandBytes, numBytes))
+  {
+    // The link is still busy; try again the next time around.
+    mLeftHandFetchState = LeftHandFetchIdle;
+  }
+}
+
+// Returns true once the request in progress has completed, with its reply bytes; a failed request has no reply bytes,
+// and sets mIsLeftHandRequestFailed. Returns false while the request is in progress.
+bool ButtonsManager::PollLeftHandRequest(const uint8_t*& replyBytes, uint8_t& numReplyBytes)
+{
+  return gLeftHandLink.PollReply(replyBytes, numReplyBytes, mIsLeftHandRequestFailed);
+}
+
+// Handles the reply to the request of the current fetch state. With the delta protocol, the number of button events is followed by
+// a request of only those events; each event is handled on its own, in the order they occurred, so that a press and release
+// within one fetch are not merged. If a request fails, or the LH Arduino dropped events, the next fetch reads a snapshot.
+void ButtonsManager::HandleLeftHandReply(const uint8_t* replyBytes, uint8_t numReplyBytes)
+{
+  LeftHandFetchState fetchState = mLeftHandFetchState;
+  mLeftHandFetchState = LeftHandFetchIdle;
+
+  if (fetchState == LeftHandSendingCommand)
   {
-    DBG_PRINT_LN("ButtonsManager::FetchLeftHandArduinoButtons - Unexpected number of bytes received from LH slave; Expected " + String(NumBytesExpectedFromLeftHandArduino) + "  but received " + String(numBytesReceived) + ".");
+    // The configuration commands have no reply; one the LH Arduino did not acknowledge is sent again.
+    if (mIsLeftHandRequestFailed)
+    {
+      DBG_PRINT_LN("ButtonsManager::HandleLeftHandReply - Command not acknowledged by LH slave; sending it again.");
+      gI2CTelemetry.LogShortRead();
+      mPendingLeftHandCommands |= mLeftHandCommandInProgress;
+    }
+    return;
+  }
 
-    // Left Hand Arduino may not be ready.
-    // Ignore results; we'll get updated button states the next time around.
+  if (fetchState == LeftHandFetchingStatus)
+  {
+    if (numReplyBytes != NumLeftHandStatusReplyBytes)
+    {
+      DBG_PRINT_LN("ButtonsManager::HandleLeftHandReply - Unexpected number of status bytes received from LH slave; Expected " + String(NumLeftHandStatusReplyBytes) + "  but received " + String(numReplyBytes) + ".");
+      HandleLeftHandShortRead();
+      return;
+    }
+
+#ifdef ENABLE_LH_FRAME_CHECK
+    if (Crc8(replyBytes, numReplyBytes - 1) != replyBytes[numReplyBytes - 1])
+    {
+      DBG_PRINT_LN("ButtonsManager::HandleLeftHandReply - Corrupted status received from LH slave; ignored.");
+      gI2CTelemetry.LogCorruptFrame();
+      return;
+    }
+#endif // ENABLE_LH_FRAME_CHECK
+
+    if (IsLeftHandRestarted(replyBytes))
+    {
+      DBG_PRINT_LN("ButtonsManager::HandleLeftHandReply - LH slave restarted; resyncing.");
+      RequestLeftHandResync();
+    }
+
+    // A requested report waits for the next status read, if this one failed.
+    if (mIsLeftHandStatusReportRequested)
+    {
+      mIsLeftHandStatusReportRequested = false;
+      gI2CTelemetry.ReportLeftHandStatus(replyBytes);
+    }
     return;
   }
 
-#if defined(DEBUG_I2C) && !defined(SEND_MIDI)
-#ifdef PRINT_LH_BUTTON_FLAGS
-  DBG_PRINT("Master: Received BassButtonFlags: b"); PRINTBIN(mNewBassButtonFlags);
-  DBG_PRINT("Master: Received ChordButtonFlags: b"); PRINTBIN(mNewChordButtonFlags);
-  DBG_PRINT("Master: Received ToneButtonFlags: b"); PRINTBIN(mNewToneButtonFlags);
+  if (fetchState == LeftHandFetchingSnapshot)
+  {
+    // Verify expected number of bytes received.
+    if (numReplyBytes != NumLeftHandSnapshotReplyBytes)
+    {
+      DBG_PRINT_LN("ButtonsManager::HandleLeftHandReply - Unexpected number of bytes received from LH slave; Expected " + String(NumLeftHandSnapshotReplyBytes) + "  but received " + String(numReplyBytes) + ".");
+
+      // Left Hand Arduino may not be ready.
+      // Ignore results; we'll get updated button states the next time around.
+      HandleLeftHandShortRead();
+      return;
+    }
+
+#ifdef ENABLE_LH_FRAME_CHECK
+    if (Crc8(replyBytes, numReplyBytes - 1) != replyBytes[numReplyBytes - 1])
+    {
+      DBG_PRINT_LN("ButtonsManager::HandleLeftHandReply - Corrupted snapshot received from LH slave; resyncing.");
+      gI2CTelemetry.LogCorruptFrame();
+      RequestLeftHandResync();
+      return;
+    }
+
+    // The button flags are unchanged if the generation is; skip them.
+    uint8_t generation = replyBytes[0];
+    bool isUnchanged = mIsLeftHandGenerationValid && generation == mLeftHandGeneration;
+    mLeftHandGeneration = generation;
+    mIsLeftHandGenerationValid = true;
+
+    replyBytes++;
+    numReplyBytes = isUnchanged ? 0 : NumBytesExpectedFromLeftHandArduino;
+#endif // ENABLE_LH_FRAME_CHECK
+
+    for (uint8_t i = 0; i < numReplyBytes; i++)
+    {
+      UpdateNewButtonFlags(replyBytes[i], i);
+    }
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+    mIsLeftHandSnapshotRequired = false;
 #endif
 
-  // // Cast 16-bit words as arrays of bytes.
-  // uint8_t* BassButtonBytes = (byte*)&mNewBassButtonFlags;
-  // uint8_t* ChordButtonBytes = (byte*)&mNewChordButtonFlags;
-  // uint8_t* ToneButtonBytes = (byte*)&mNewToneButtonFlags;
+    LogLeftHandFetch();
+    return;
+  }
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+  if (fetchState == LeftHandFetchingEventCount)
+  {
+    if (numReplyBytes != 1)
+    {
+      // Left Hand Arduino may not be ready; ask again the next time around.
+      HandleLeftHandShortRead();
+      return;
+    }
+
+    if (replyBytes[0] == 0)
+    {
+      // No button changed.
+      return;
+    }
 
-  // DBG_PRINT_LN(String("Master: Received BassButtonBytes=") + String(BassButtonBytes[0], HEX) + String(BassButtonBytes[1], HEX));
-  // DBG_PRINT_LN(String("Master: Received ChordButtonBytes=") + String(ChordButtonBytes[0], HEX) + String(ChordButtonBytes[1], HEX));
-  // DBG_PRINT_LN(String("Master: Received ToneButtonBytes=") + String(ToneButtonBytes[0], HEX) + String(ToneButtonBytes[1], HEX));
+    uint8_t numButtonEvents = replyBytes[0];
+    if (numButtonEvents > MaxLeftHandButtonEventsPerFetch)
+    {
+      // LeftHandSnapshotRequired.
+      mIsLeftHandSnapshotRequired = true;
+      StartLeftHandRequest(LeftHandFetchingSnapshot, ReadLeftHandSnapshot, NumLeftHandSnapshotReplyBytes);
+      return;
+    }
+
+    StartLeftHandRequest(LeftHandFetchingEvents, ReadLeftHandEvents, numButtonEvents + NumLeftHandEventsCheckBytes);
+    return;
+  }
+
+  if (fetchState == LeftHandFetchingEvents)
+  {
+#ifdef ENABLE_LH_FRAME_CHECK
+    // Apply none of the events of a short, or corrupted, reply.
+    if (numReplyBytes != mNumLeftHandBytesRequested || Crc8(replyBytes, numReplyBytes - 1) != replyBytes[numReplyBytes - 1])
+    {
+      DBG_PRINT_LN("ButtonsManager::HandleLeftHandReply - Short, or corrupted, events received from LH slave; reading snapshot.");
+      if (numReplyBytes != mNumLeftHandBytesRequested)
+      {
+        HandleLeftHandShortRead();
+      }
+      else
+      {
+        gI2CTelemetry.LogCorruptFrame();
+      }
+
+      mIsLeftHandSnapshotRequired = true;
+      return;
+    }
+
+    numReplyBytes -= NumLeftHandEventsCheckBytes;
+    mNumLeftHandBytesRequested -= NumLeftHandEventsCheckBytes;
+#endif // ENABLE_LH_FRAME_CHECK
+
+    for (uint8_t i = 0; i < numReplyBytes; i++)
+    {
+      if (!UpdateNewButtonFlags(replyBytes[i]))
+      {
+        mIsLeftHandSnapshotRequired = true;
+        break;
+      }
+
+      UpdateLeftHandButtonStates();
+    }
+
+    if (numReplyBytes != mNumLeftHandBytesRequested)
+    {
+      HandleLeftHandShortRead();
+    }
+
+    if (numReplyBytes != mNumLeftHandBytesRequested || mIsLeftHandSnapshotRequired)
+    {
+      DBG_PRINT_LN("ButtonsManager::HandleLeftHandReply - Expected " + String(mNumLeftHandBytesRequested) + " events but received " + String(numReplyBytes) + "; reading snapshot.");
+      mIsLeftHandSnapshotRequired = true;
+      return;
+    }
+
+    LogLeftHandFetch();
+  }
+#endif // ENABLE_I2C_DELTA_PROTOCOL
+}
+
+// Logs a short read; the LH Arduino may not be ready, e.g. while it restarts. Its next snapshot is then applied, even if its generation is unchanged.
+void ButtonsManager::HandleLeftHandShortRead()
+{
+  gI2CTelemetry.LogShortRead();
+
+#ifdef ENABLE_LH_FRAME_CHECK
+  mIsLeftHandGenerationValid = false;
+#endif
+}
+
+// Returns true if the LH uptime of the status passed in fell behind that of the last status by more than LeftHandUptimeToleranceSeconds;
+// the LH Arduino then restarted since, and lost its configuration, and the generation of its snapshots.
+bool ButtonsManager::IsLeftHandRestarted(const uint8_t* statusBytes)
+{
+  uint16_t uptimeSeconds = word(statusBytes[LeftHandStatusUptimeHigh], statusBytes[LeftHandStatusUptimeLow]);
+  unsigned long curTimeMs = mScanFrame.timeMs;
+
+  // The uptime the LH Arduino would report, had it not restarted; in 16 bits, as the reported uptime wraps.
+  uint16_t expectedUptimeSeconds = mLeftHandUptimeSeconds + (curTimeMs - mLeftHandUptimeTimeMs) / 1000;
+  uint16_t lostUptimeSeconds = expectedUptimeSeconds - uptimeSeconds;
+  bool isRestarted = mIsLeftHandUptimeValid && lostUptimeSeconds > LeftHandUptimeToleranceSeconds && lostUptimeSeconds < 0x8000;
+
+  mLeftHandUptimeSeconds = uptimeSeconds;
+  mLeftHandUptimeTimeMs = curTimeMs;
+  mIsLeftHandUptimeValid = true;
+  return isRestarted;
+}
+
+// Prints the received button flags, and the fetch time, if DEBUG_I2C is defined. Called when a fetch has completed.
+void ButtonsManager::LogLeftHandFetch()
+{
+#if defined(DEBUG_I2C) && !defined(SEND_MIDI)
+#ifdef PRINT_LH_BUTTON_FLAGS
+  for (uint8_t i = 0; i < NumLeftHandButtonBanks; i++)
+  {
+    DBG_PRINT("Master: Received Bank " + String(mLeftHandBanks[i].bank) + " ButtonFlags: b"); PRINTBIN(mLeftHandBanks[i].newFlags);
+  }
+#endif
 
   uint32_t endTimeMicroseconds = micros();
-  unsigned long fetchTimeMicroseconds = endTimeMicroseconds - startTimeMicroseconds;
+  unsigned long fetchTimeMicroseconds = endTimeMicroseconds - lastFetchTimeMicroseconds;
   fetchTimesMicroseconds[numFetches] = fetchTimeMicroseconds;
   numFetches++;
 
-  DBG_PRINT_LN("ButtonsManager::FetchLeftHandArduinoButtons - Master: Fetch time = " + String(fetchTimeMicroseconds) + " Microseconds.");
+  DBG_PRINT_LN("ButtonsManager::LogLeftHandFetch - Master: Fetch time = " + String(fetchTimeMicroseconds) + " Microseconds.");
 
   if (numFetches >= MaxFetches)
   {
@@ -255,230 +862,306 @@ void ButtonsManager::FetchLeftHandArduinoButtons()
     }
     unsigned long avgFetchTimeMicroseconds = totalFetchTimeMicroseconds / MaxFetches;
 
-    DBG_PRINT_LN("ButtonsManager::FetchLeftHandArduinoButtons - Master: Average time for I2C request/response = " + String(avgFetchTimeMicroseconds) + " Microseconds. Max fetch interval = " + String(maxTimeBetweenFetchesMicroseconds) + " Microseconds.");
+    DBG_PRINT_LN("ButtonsManager::LogLeftHandFetch - Master: Average time for I2C request/response = " + String(avgFetchTimeMicroseconds) + " Microseconds. Max fetch interval = " + String(maxTimeBetweenFetchesMicroseconds) + " Microseconds.");
   }
-  // DBG_PRINT_LN("Master: Elapsed time for I2C request/response = " + String(endTimeMicroSeconds) + " - " + String(startTimeMicroSeconds) + " = " + String(endTimeMicroSeconds - startTimeMicroSeconds) + " Microseconds.");
-
 #endif // DEBUG_I2C && !SEND_MIDI
+}
+
+#ifdef ENABLE_LH_DATA_READY_LINE
 
-  UpdateLeftHandButtonStates();
+// Returns true if the LH Arduino signals data ready, or the keep-alive poll interval has elapsed since the last request.
+// The keep-alive poll recovers from a missed signal, or an unconnected data ready line.
+bool ButtonsManager::IsLeftHandFetchDue()
+{
+  unsigned long curTimeMs = mScanFrame.timeMs;
+  if (digitalRead(LeftHandDataReadyPin) != LOW && curTimeMs - mLastLeftHandFetchTimeMs < LeftHandKeepAlivePollIntervalMs)
+  {
+    return false;
+  }
+
+  mLastLeftHandFetchTimeMs = curTimeMs;
+  return true;
 }
 
-// This method updates all Left Hand Buttons states after the button flags have been updated from the I2C response from the LH Arduino.
-// This method also includes the Volume Potentiometer analog input value.
-// This method is called by the RH Arduino. It only updates the button state after the debounce time has elapsed.
-void ButtonsManager::UpdateLeftHandButtonStates()
+#endif // ENABLE_LH_DATA_READY_LINE
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+
+// This method applies a LH button event received from the LH Arduino to the button flag members.
+// Returns false if the event is not of a LH button.
+bool ButtonsManager::UpdateNewButtonFlags(uint8_t buttonEvent)
 {
-  unsigned long lastToggleTimeMs = millis();
+  uint8_t buttonIndex = buttonEvent & LeftHandButtonEventIndexMask;
+  if (buttonIndex >= NumLeftHandButtons)
+  {
+    return false;
+  }
 
-  // TODO: Replace magic numbers here and elsewhere.
-  Button* bassButtons = &mLeftHandButtons[0];
-  Button* chordButtons = &mLeftHandButtons[12];
-  Button* toneButtons = &mLeftHandButtons[24];
+  ButtonBank bank = LeftHandButtonLayout::GetBank(buttonIndex);
+  uint16_t& newFlags = mLeftHandBanks[bank - FirstLeftHandButtonBank].newFlags;
 
-  // Bass Button Flags
-  if (mCurBassButtonFlags != mNewBassButtonFlags)
+  uint8_t bankButtonIndex = buttonIndex - GetBankFirstButtonIndex(bank);
+  if ((buttonEvent & LeftHandButtonEventActiveFlag) != 0)
   {
-    // Determine which bits changed, and update corresponding mLeftHandButtons.
-    // Note Indexes 00-11 (Bass)
-    for (int i = 0; i < 12; i++)
-    {
-      uint16_t buttonMask = 0x00000001 << i;
-      uint16_t oldFlag = mCurBassButtonFlags & buttonMask;
-      uint16_t newFlag = mNewBassButtonFlags & buttonMask;
-      if (oldFlag != newFlag)
-      {
-        Button& curButton = bassButtons[i];
-        if (IsButtonDebounced(curButton))
-        {
-          // DBG_PRINT("ButtonsManager.Update() - OldBassButtonFlags: b"); PRINTBIN(mCurBassButtonFlags);
-          // DBG_PRINT("ButtonsManager.Update() - NewBassButtonMask: b"); PRINTBIN(mNewBassButtonFlags);
+    BIT_SET(newFlags, bankButtonIndex);
+  }
+  else
+  {
+    BIT_CLEAR(newFlags, bankButtonIndex);
+  }
 
-          bool isActive = newFlag != 0;
-          bool isToggled = curButton.buttonState.active != isActive;
-          curButton.buttonState.active = isActive;
+  return true;
+}
 
-          // Only handle change, reset toggle time, and update the CurButtonFlags bit state only if button state was toggled.
-          if (isToggled)
-          {
-            curButton.lastToggleTimeMs = lastToggleTimeMs;
-  
-            // DBG_PRINT_LN("ButtonsManager.Update() - BassButton["+ String(i) + "]: isActive = " + String(curButton.buttonState.active));
-            bassButtonChangedHandler.HandleButtonChange(mLeftHandButtons, i + 0);
-
-            if (isActive)
-            {
-              BIT_SET(mCurBassButtonFlags, i);
-            }
-            else
-            {
-              BIT_CLEAR(mCurBassButtonFlags, i);
-            }
-          }
-        }
-      }
+#endif // ENABLE_I2C_DELTA_PROTOCOL
+
+// Returns true if the LH button flags equal the current button states, and no button is settling; UpdateLeftHandButtonStates() would then change nothing.
+bool ButtonsManager::IsLeftHandSettled()
+{
+  for (uint8_t i = 0; i < NumLeftHandButtonBanks; i++)
+  {
+    LeftHandBankState& bankState = mLeftHandBanks[i];
+    if (bankState.newFlags != bankState.curFlags || (ButtonDebounceStrategy == VerticalCounterDebounce && !bankState.debouncer.IsSettled()))
+    {
+      return false;
     }
   }
 
-  // Chord Button Flags
-  if (mCurChordButtonFlags != mNewChordButtonFlags)
+  return !mLeftHandButtons->IsAnyButtonSettling();
+}
+
+// This method updates all Left Hand Buttons states after the button flags have been updated from the I2C response from the LH Arduino.
+// This method also includes the Volume Potentiometer analog input value.
+// This method is called by the RH Arduino. It only updates the button state per the bank's debounce policy,
+// unless the LH Arduino already debounced the button states (ENABLE_LH_SLAVE_DEBOUNCE).
+void ButtonsManager::UpdateLeftHandButtonStates()
+{
+  unsigned long curTimeMs = mScanFrame.timeMs;
+
+#ifndef ENABLE_LH_SLAVE_DEBOUNCE
+  mLeftHandButtons->ExpireSettledButtons(curTimeMs);
+#endif
+
+  for (uint8_t i = 0; i < NumLeftHandButtonBanks; i++)
   {
-    // Note Indexes 12-23 (Chords)
-    for (int i = 0; i < 12; i++)
-    {
-      uint16_t buttonMask = 0x00000001 << i;
-      uint16_t oldFlag = mCurChordButtonFlags & buttonMask;
-      uint16_t newFlag = mNewChordButtonFlags & buttonMask;
+    mScanFrame.leftHandButtonFlags[i] = mLeftHandBanks[i].newFlags;
+    UpdateLeftHandBank(mLeftHandBanks[i], curTimeMs);
+  }
+}
 
-      if (oldFlag != newFlag)
-      {
-        Button& curButton = chordButtons[i];
-        if (IsButtonDebounced(curButton))
-        {
-          // DBG_PRINT("ButtonsManager.Update() - OldChordButtonFlags: b"); PRINTBIN(mCurChordButtonFlags);
-          // DBG_PRINT("ButtonsManager.Update() - NewChordButtonMask: b"); PRINTBIN(mNewChordButtonFlags);
-
-          bool isActive = newFlag != 0;
-          bool isToggled = curButton.buttonState.active != isActive;
-          curButton.buttonState.active = isActive;
-
-          // Only handle change, reset toggle time, and update the CurButtonFlags bit state only if button state was toggled.
-          if (isToggled)
-          {
-            curButton.lastToggleTimeMs = lastToggleTimeMs;
-
-            // DBG_PRINT_LN("ButtonsManager.Update() - ChordButton["+ String(i) + "]: isActive = " + String(curButton.buttonState.active));
-            chordButtonChangedHandler.HandleButtonChange(mLeftHandButtons, i + 12);
-
-            if (isActive)
-            {
-              BIT_SET(mCurChordButtonFlags, i);
-            }
-            else
-            {
-              BIT_CLEAR(mCurChordButtonFlags, i);
-            }
-          }
-        }
-      }
+// This method determines which buttons of a bank of Left Hand Button flags toggled, and handles each with the bank's handler.
+// Only the set bits of the bitmap of buttons to visit are walked, lowest first, so the cost is proportional to the number of changes.
+// - ENABLE_LH_SLAVE_DEBOUNCE: the LH Arduino already debounced the flags; the changed buttons toggle.
+// - VerticalCounterDebounce: the bank's vertical counters debounce all the flags at once; the buttons they toggled toggle.
+// - TimeWindowDebounce: the changed buttons, and, with EagerPressDebounce, also the active buttons, to cancel releases that are still settling,
+//   are visited; each toggles only if accepted by the bank's debounce policy.
+// The bank's current flags are updated to the toggled button states.
+void ButtonsManager::UpdateLeftHandBank(LeftHandBankState& bankState, unsigned long curTimeMs)
+{
+  ButtonBank bank = bankState.bank;
+  DebouncePolicy debouncePolicy = BankDebouncePolicies[bank];
+
+  // Set if each visited button toggles; otherwise, the debounce policy decides, per button.
+  bool isDebounced = true;
+  uint16_t visitFlags;
+
+#ifdef ENABLE_LH_SLAVE_DEBOUNCE
+  visitFlags = bankState.curFlags ^ bankState.newFlags;
+  bankState.curFlags = bankState.newFlags;
+#else
+  if (ButtonDebounceStrategy == VerticalCounterDebounce)
+  {
+    uint16_t eagerPressFlags = debouncePolicy == EagerPressDebounce ? 0xFFFF : 0;
+    visitFlags = bankState.debouncer.Update(bankState.newFlags, curTimeMs, eagerPressFlags);
+    bankState.curFlags = bankState.debouncer.GetDebouncedButtons();
+  }
+  else
+  {
+    isDebounced = false;
+    visitFlags = bankState.curFlags ^ bankState.newFlags;
+    if (debouncePolicy == EagerPressDebounce)
+    {
+      visitFlags |= bankState.curFlags;
     }
   }
+#endif // ENABLE_LH_SLAVE_DEBOUNCE
+
+  if (visitFlags == 0)
+  {
+    return;
+  }
+
+  uint16_t buttonFlags = isDebounced ? bankState.curFlags : bankState.newFlags;
+  byte firstButtonIndex = GetBankFirstButtonIndex(bank);
 
-  // Tone Button Flags
-  if (mCurToneButtonFlags != mNewToneButtonFlags)
+  ButtonEvent buttonEvent;
+  buttonEvent.timeMicroseconds = mScanFrame.timeMicroseconds;
+  buttonEvent.bank = bank;
+  while (visitFlags != 0)
   {
-     // Toggle Switches Indexes 24-37
-    for (int i = 0; i < 14; i++) // TODO: Magic numbers; here and elsewhere.
+    uint8_t bankButtonIndex = __builtin_ctz(visitFlags);
+    visitFlags &= visitFlags - 1;
+
+    byte buttonIndex = firstButtonIndex + bankButtonIndex;
+    bool isActive = (buttonFlags >> bankButtonIndex) & 1;
+    if (!isDebounced)
     {
-      uint16_t buttonMask = 0x00000001 << i;
-      uint16_t oldFlag = mCurToneButtonFlags & buttonMask;
-      uint16_t newFlag = mNewToneButtonFlags & buttonMask;
+      if (!IsButtonToggleAccepted(*mLeftHandButtons, buttonIndex, isActive, debouncePolicy, curTimeMs))
+      {
+        continue;
+      }
 
-      if (oldFlag != newFlag)
+      mLeftHandButtons->StartSettling(buttonIndex, curTimeMs);
+      if (isActive)
       {
-        Button& curButton = toneButtons[i];
-        if (IsButtonDebounced(curButton))
-        {
-          // DBG_PRINT("ButtonsManager.Update() - OldToneButtonFlags: b"); PRINTBIN(mCurToneButtonFlags);
-          // DBG_PRINT("ButtonsManager.Update() - NewToneButtonMask: b"); PRINTBIN(mNewToneButtonFlags);
-
-          bool isActive = newFlag != 0;
-          bool isToggled = curButton.buttonState.active != isActive;
-          curButton.buttonState.active = isActive;
-         
-          // Only handle change, reset toggle time, and update the CurButtonFlags bit state only if button state was toggled.
-          if (isToggled)
-          {
-            curButton.lastToggleTimeMs = lastToggleTimeMs;
-            
-            // DBG_PRINT_LN("ButtonsManager.Update() - ToneButton["+ String(i) + "]: isActive = " + String(curButton.buttonState.active));
-            toneButtonChangedHandler.HandleButtonChange(mLeftHandButtons, i + 24);
-
-            if (isActive)
-            {
-              BIT_SET(mCurToneButtonFlags, i);
-            }
-            else
-            {
-              BIT_CLEAR(mCurToneButtonFlags, i);
-            }
-          }
-        }
+        BIT_SET(bankState.curFlags, bankButtonIndex);
+      }
+      else
+      {
+        BIT_CLEAR(bankState.curFlags, bankButtonIndex);
       }
     }
+
+    // DBG_PRINT_LN("ButtonsManager.UpdateLeftHandBank() - Button["+ String(buttonIndex) + "]: isActive = " + String(isActive));
+    mLeftHandButtons->SetActive(buttonIndex, isActive);
+
+    buttonEvent.buttonIndex = buttonIndex;
+    buttonEvent.isActive = isActive;
+    AddButtonEvent(*mLeftHandButtons, buttonEvent, *bankState.buttonChangedHandler);
   }
 }
 
 // This method updates the button flag members with the received byte from the LH Arduino over I2C.
 void ButtonsManager::UpdateNewButtonFlags(uint8_t receivedByte, int receivedByteIndex)
 {
-  // Left Hand slave sends bytes in the following order.
+  // Left Hand slave sends 2 bytes per bank, low byte first, in bank order.
   //  (2) Bass Button bytes
   //  (2) Chord Button bytes
   //  (2) Tone Button bytes
-
-  // Cast 16-bit words as arrays of bytes.
-  uint8_t* BassButtonBytes = (byte*)&mNewBassButtonFlags;
-  uint8_t* ChordButtonBytes = (byte*)&mNewChordButtonFlags;
-  uint8_t* ToneButtonBytes = (byte*)&mNewToneButtonFlags;
+  uint8_t bankIndex = receivedByteIndex / 2;
+  if (bankIndex >= NumLeftHandButtonBanks)
+  {
+    return;
+  }
 
   // DBG_PRINT_LN("ButtonsManager.UpdateNewButtonFlags() - receivedByte[" + String(receivedByteIndex) + "] = " + String(receivedByte, HEX));
-  // DBG_PRINT_LN("ButtonsManager.UpdateNewButtonFlags() - Before mNewBassButtonFlags = " + String(mNewBassButtonFlags, HEX));
-  // DBG_PRINT_LN("ButtonsManager.UpdateNewButtonFlags() - Before mNewChordButtonFlags = " + String(mNewChordButtonFlags, HEX));
-  // DBG_PRINT_LN("ButtonsManager.UpdateNewButtonFlags() - Before mNewToneButtonFlags = " + String(mNewToneButtonFlags, HEX));
+  uint16_t& newFlags = mLeftHandBanks[bankIndex].newFlags;
+  if ((receivedByteIndex & 1) == 0)
+  {
+    newFlags = (newFlags & 0xFF00) | receivedByte;
+  }
+  else
+  {
+    newFlags = (newFlags & 0x00FF) | ((uint16_t)receivedByte << 8);
+  }
+}
+#endif // BUILD_RIGHT_HAND_MASTER
 
-  switch(receivedByteIndex)
+// Returns the bank of the button at the index passed in, of either the RH or LH ButtonArray.
+ButtonBank ButtonsManager::GetButtonBank(ButtonArray& buttons, byte buttonIndex)
+{
+  if (&buttons == mRightHandButtons)
   {
-    case 0:
-      BassButtonBytes[0] = receivedByte;
-      break;
-    case 1:
-      BassButtonBytes[1] = receivedByte;
-      break;
-    case 2:
-      ChordButtonBytes[0] = receivedByte;
-      break;
-    case 3:
-      ChordButtonBytes[1] = receivedByte;
-      break;
-    case 4:
-      ToneButtonBytes[0] = receivedByte;
-      break;
-    case 5:
-      ToneButtonBytes[1] = receivedByte;
-      break;
+    return RightHandButtonLayout::GetBank(buttonIndex);
   }
 
-  // DBG_PRINT_LN("ButtonsManager.UpdateNewButtonFlags() - After mNewBassButtonFlags = " + String(mNewBassButtonFlags, HEX));
-  // DBG_PRINT_LN("ButtonsManager.UpdateNewButtonFlags() - After mNewChordButtonFlags = " + String(mNewChordButtonFlags, HEX));
-  // DBG_PRINT_LN("ButtonsManager.UpdateNewButtonFlags() - After mNewToneButtonFlags = " + String(mNewToneButtonFlags, HEX));
+  return LeftHandButtonLayout::GetBank(buttonIndex);
+}
+
+// This method adds the button event to the ScanFrame, for the button changed handler. The button state must already be saved.
+// If the frame is full, its button events are dispatched first, so that no event is lost, and the order is kept.
+void ButtonsManager::AddButtonEvent(ButtonArray& buttons, const ButtonEvent& buttonEvent, ButtonChangedHandlerBase& buttonChangedHandler)
+{
+  if (mScanFrame.numButtonEvents >= MaxScanFrameButtonEvents)
+  {
+    DispatchButtonEvents();
+  }
+
+  ScanFrameButtonEvent& scanFrameButtonEvent = mScanFrame.buttonEvents[mScanFrame.numButtonEvents++];
+  scanFrameButtonEvent.buttonEvent = buttonEvent;
+  scanFrameButtonEvent.buttons = &buttons;
+  scanFrameButtonEvent.buttonChangedHandler = &buttonChangedHandler;
+  mScanFrame.totalButtonEvents++;
+}
+
+// This method passes the button events of the ScanFrame to their button changed handlers, in the order they were added.
+// loop() calls it once the RH buttons are read, so their MIDI messages do not wait for the sensor reads, and the LH fetch;
+// EndScanFrame() then passes the LH button events.
+// It is the single point through which all button changes flow; uncomment LOG_BUTTON_EVENT_LATENCY() to measure
+// the time from when the change was sampled until its handler, e.g. the MIDI message, has completed.
+void ButtonsManager::DispatchButtonEvents()
+{
+  for (uint8_t i = 0; i < mScanFrame.numButtonEvents; i++)
+  {
+    ScanFrameButtonEvent& scanFrameButtonEvent = mScanFrame.buttonEvents[i];
+    scanFrameButtonEvent.buttonChangedHandler->HandleButtonEvent(*scanFrameButtonEvent.buttons, scanFrameButtonEvent.buttonEvent);
+
+    // LOG_BUTTON_EVENT_LATENCY(scanFrameButtonEvent.buttonEvent);
+  }
+
+  mScanFrame.numButtonEvents = 0;
+}
+
+// This method passes the sensors whose value changed in the ScanFrame to the sensor changed handler.
+void ButtonsManager::DispatchSensorChanges()
+{
+  uint8_t changedSensors = mScanFrame.changedSensors;
+  while (changedSensors != 0)
+  {
+    uint8_t i = __builtin_ctz(changedSensors);
+    changedSensors &= changedSensors - 1;
+
+    mScanFrame.sensorChangedHandler->HandleSensorChange(mScanFrame.sensors, i);
+  }
+
+  mScanFrame.changedSensors = 0;
 }
-#endif // BUILD_RIGHT_HAND_MASTER
 
 // TODO: bjk 220111 Move debounce into button class, per https://roboticsbackend.com/arduino-object-oriented-programming-oop/
 // Returns true if it is OK to handle button state toggle.
 // This function returns true if the time between the current time and
 // the last button state toggle time is greater than the debounce time.
-bool ButtonsManager::IsButtonDebounced(const Button& button)
+bool ButtonsManager::IsButtonDebounced(ButtonArray& buttons, byte buttonIndex, unsigned long curTimeMs)
 {
-  unsigned long curTimeMs = millis();
-
   // Ignore current state until past the button settling time.
-  unsigned long elapsedTimeMs = curTimeMs - button.lastToggleTimeMs;
+  return buttons.IsSettled(buttonIndex, curTimeMs);
+}
 
-  if (elapsedTimeMs < DebounceDelayMs) {
-    // Last button toggle time is too recent. Prevent changing its state.
-//    if (button.buttonState.active) {
-//      DBG_PRINT_LN("Button " + String(button.buttonState.pin) + " elapsedTimeMs = " + String(elapsedTimeMs));
-//    }
+// Returns true if it is OK to toggle the button to the pressed state passed in, per the debounce policy passed in.
+// SymmetricDebounce: The state must differ, and the debounce time must have elapsed since the last toggle.
+// EagerPressDebounce: A press is accepted on its first edge. A release is accepted only after the button has read
+// released for the debounce time; a re-press while the release is settling cancels the release.
+// While a release is settling, the button's debounce time is started at the time the release started.
+bool ButtonsManager::IsButtonToggleAccepted(ButtonArray& buttons, byte buttonIndex, bool isPressed, DebouncePolicy debouncePolicy, unsigned long curTimeMs)
+{
+  if (debouncePolicy == SymmetricDebounce)
+  {
+    return buttons.IsActive(buttonIndex) != isPressed && IsButtonDebounced(buttons, buttonIndex, curTimeMs);
+  }
 
+  if (isPressed)
+  {
+    buttons.SetReleasePending(buttonIndex, false);
+    return !buttons.IsActive(buttonIndex);
+  }
+
+  if (!buttons.IsActive(buttonIndex))
+  {
     return false;
   }
-  else {
-//    if (button.buttonState.active) {
-//      DBG_PRINT_LN("Debounce Button " + String(button.buttonState.pin) + " completed." + " elapsedTimeMs = " + String(elapsedTimeMs));
-//    }
 
-    return true;
+  if (!buttons.IsReleasePending(buttonIndex))
+  {
+    buttons.SetReleasePending(buttonIndex, true);
+    buttons.StartSettling(buttonIndex, curTimeMs);
+    return false;
   }
+
+  if (!buttons.IsSettled(buttonIndex, curTimeMs))
+  {
+    return false;
+  }
+
+  buttons.SetReleasePending(buttonIndex, false);
+  return true;
 }
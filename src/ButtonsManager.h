@@ -32,28 +32,60 @@
 #include "MIDIAccordion.h"
 
 #include "Button.h"
+#include "ButtonEvent.h"
+#include "ButtonLayout.h"
+#include "InputZone.h"
+#include "ScanFrame.h"
 #include "Sensor.h"
+#include "VerticalCounterDebouncer.h"
+
+#ifdef ENABLE_PORT_REGISTER_SCAN
+#include "ButtonPortScanner.h"
+#endif
+#ifdef ENABLE_TIMER_KEY_SCAN
+#include "TimerKeyScanner.h"
+#endif
+#ifdef ENABLE_PIN_CHANGE_CAPTURE
+#include "PinChangeCapture.h"
+#endif
 #include "ButtonChangedHandlers/ButtonChangedHandlerBase.h"
 #include "SensorChangedHandlers/SensorChangedHandlerBase.h"
 
+// A LH bank's button flags are one word.
+static_assert(GetMaxBankNumButtons(FirstLeftHandButtonBank) <= 16, "A LH bank holds at most 16 buttons.");
+
 // TODO: Split into LeftHandButtonsManager and RightHandButtonsManager, keeping common function in base class, ButtonsManager.
 class ButtonsManager {
 
 private:
-  Button* mLeftHandButtons;
-  Button* mRightHandButtons;
+  ButtonArray* mLeftHandButtons;
+  ButtonArray* mRightHandButtons;
 
   Sensor* mLeftHandSensors;
   Sensor* mRightHandSensors;
 
-  uint16_t mCurBassButtonFlags = 0;
-  uint16_t mCurChordButtonFlags = 0;
-  uint16_t mCurToneButtonFlags = 0;
-
 public:
-  ButtonsManager(Button* leftHandButtons, Button* rightHandButtons, Sensor* leftHandSensors, Sensor* rightHandSensors);
+  ButtonsManager(ButtonArray* leftHandButtons, ButtonArray* rightHandButtons, Sensor* leftHandSensors, Sensor* rightHandSensors);
+
+  void BeginScanFrame();
+  void DispatchButtonEvents();
+  void EndScanFrame();
+  const ScanFrame& GetScanFrame() const;
 
-  void ReadButtons(Button* buttons, int startButtonIndex, int endButtonIndex, ButtonChangedHandlerBase& buttonChangedHandler, bool debounce);
+  void ReadButtons(ButtonArray& buttons, const InputZone* inputZones, uint8_t numInputZones, bool debounce);
+
+#ifdef ENABLE_PORT_REGISTER_SCAN
+  void ReadButtons(ButtonPortScanner& buttonPortScanner, const InputZone* inputZones, uint8_t numInputZones, bool debounce);
+  void ReadButtons(ButtonPortScanner& buttonPortScanner, ButtonChangedHandlerBase& buttonChangedHandler, bool debounce);
+#endif
+
+#ifdef ENABLE_PIN_CHANGE_CAPTURE
+  void ReadButtons(ButtonPortScanner& buttonPortScanner, PinChangeCapture& pinChangeCapture, ButtonChangedHandlerBase& buttonChangedHandler, bool debounce);
+#endif
+
+#ifdef ENABLE_TIMER_KEY_SCAN
+  void DispatchButtonEvents(TimerKeyScanner& timerKeyScanner, ButtonChangedHandlerBase& buttonChangedHandler);
+#endif
 
 #ifdef BUILD_RIGHT_HAND_MASTER
   void ReadSensors(Sensor* sensors, int numSensors, SensorChangedHandlerBase& sensorChangedHandler);
@@ -62,30 +94,143 @@ public:
 #ifdef BUILD_RIGHT_HAND_MASTER
   // This method is only used by the RH Arduino.
   void FetchLeftHandArduinoButtons();
+
+  // These methods queue a command to the LH Arduino, which is sent between fetches; see LeftHandI2CCommand.
+  void SetLeftHandScanIntervalMicroseconds(uint16_t scanIntervalMicroseconds);
+  void SetLeftHandDebounceDelayMs(uint8_t debounceDelayMs);
+  void RequestLeftHandResync();
+  void RequestLeftHandStatus();
 #endif
 
 protected:
   // The default constructor is protected to prevent its usage.
   ButtonsManager();
 
+#ifdef ENABLE_PORT_REGISTER_SCAN
+  InputZone GetBankInputZone(ButtonPortScanner& buttonPortScanner, ButtonChangedHandlerBase& buttonChangedHandler);
+  void UpdateZoneButtons(ButtonPortScanner& buttonPortScanner, const InputZone* inputZones, uint8_t numInputZones, uint64_t pressedButtons,
+                         uint64_t capturedPresses, unsigned long capturedPressTimeMicroseconds, bool debounce);
+#endif
+
 #ifdef BUILD_RIGHT_HAND_MASTER
+  // The steps of a fetch of the LH button states; see FetchLeftHandArduinoButtons().
+  enum LeftHandFetchState : uint8_t
+  {
+    LeftHandFetchIdle,
+    LeftHandFetchingSnapshot,
+    LeftHandFetchingEventCount,
+    LeftHandFetchingEvents,
+
+    // A command to the LH Arduino; not part of a fetch.
+    LeftHandSendingCommand,
+    LeftHandFetchingStatus
+  };
+
+  // The commands queued for the LH Arduino; one bit each, sent lowest bit first.
+  enum LeftHandPendingCommand : uint8_t
+  {
+    LeftHandScanIntervalPending = 0x01,
+    LeftHandDebounceDelayPending = 0x02,
+    LeftHandSnapshotPending = 0x04,
+    LeftHandStatusPending = 0x08
+  };
+
+  // The state of a bank of LH buttons; one bit per button of the bank. See UpdateLeftHandBank().
+  struct LeftHandBankState
+  {
+    ButtonBank bank;
+    ButtonChangedHandlerBase* buttonChangedHandler;
+
+    // As received from the LH Arduino, and as last handled.
+    uint16_t newFlags;
+    uint16_t curFlags;
+
+    // Used only if ButtonDebounceStrategy is VerticalCounterDebounce.
+    VerticalCounterDebouncer<uint16_t> debouncer;
+  };
+
   // The following methods are only used by the RH Arduino.
+  void StartLeftHandFetch();
+  void StartLeftHandCommand();
+  void StartLeftHandRequest(LeftHandFetchState fetchState, uint8_t command, uint8_t numBytes);
+  void StartLeftHandRequest(LeftHandFetchState fetchState, const uint8_t* commandBytes, uint8_t numCommandBytes, uint8_t numBytes);
+  bool PollLeftHandRequest(const uint8_t*& replyBytes, uint8_t& numReplyBytes);
+  void HandleLeftHandReply(const uint8_t* replyBytes, uint8_t numReplyBytes);
+  void HandleLeftHandShortRead();
+  bool IsLeftHandRestarted(const uint8_t* statusBytes);
+  void LogLeftHandFetch();
   void UpdateNewButtonFlags(uint8_t receivedByte, int index);
+#ifdef ENABLE_LH_DATA_READY_LINE
+  bool IsLeftHandFetchDue();
+#endif
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+  bool UpdateNewButtonFlags(uint8_t buttonEvent);
+#endif
+  bool IsLeftHandSettled();
   void UpdateLeftHandButtonStates();
+  void UpdateLeftHandBank(LeftHandBankState& bankState, unsigned long curTimeMs);
 #endif
 
 private:
-  bool IsButtonDebounced(const Button& button);
+  ButtonBank GetButtonBank(ButtonArray& buttons, byte buttonIndex);
+  void AddButtonEvent(ButtonArray& buttons, const ButtonEvent& buttonEvent, ButtonChangedHandlerBase& buttonChangedHandler);
+  void DispatchSensorChanges();
+  bool IsButtonDebounced(ButtonArray& buttons, byte buttonIndex, unsigned long curTimeMs);
+  bool IsButtonToggleAccepted(ButtonArray& buttons, byte buttonIndex, bool isPressed, DebouncePolicy debouncePolicy, unsigned long curTimeMs);
 
 private:
 
+  // The frame of the current pass of loop().
+  ScanFrame mScanFrame;
+
+#ifdef BUILD_RIGHT_HAND_MASTER
   // Bank 1: Bass Buttons:    01-12
   // Bank 2: Chords Buttons:  13-24
   // Bank 3: Tone Switch:     25-38
+  LeftHandBankState mLeftHandBanks[NumLeftHandButtonBanks];
+
+  LeftHandFetchState mLeftHandFetchState = LeftHandFetchIdle;
+  uint8_t mNumLeftHandBytesRequested = 0;
+
+  // The request in progress failed, e.g. the LH Arduino did not acknowledge it; set by PollLeftHandRequest().
+  bool mIsLeftHandRequestFailed = false;
+
+  // The start time of the fetch in progress, for the I2C telemetry.
+  unsigned long mLeftHandFetchStartTimeMicroseconds = 0;
+
+  // The commands queued for the LH Arduino, and the configuration they send; initially, the configuration is sent.
+  uint8_t mPendingLeftHandCommands = LeftHandScanIntervalPending | LeftHandDebounceDelayPending;
+  uint16_t mLeftHandScanIntervalMicroseconds = LeftHandScanIntervalMicroseconds;
+  uint8_t mLeftHandDebounceDelayMs = LeftHandDebounceDelayMs;
+
+  // The pending command bit of the command in progress; queued again if the command fails.
+  uint8_t mLeftHandCommandInProgress = 0;
 
-  uint16_t mNewBassButtonFlags = 0;
-  uint16_t mNewChordButtonFlags = 0;
-  uint16_t mNewToneButtonFlags = 0;
+  // The status is read every LeftHandStatusPollIntervalMs, to detect a LH Arduino restart; and reported, if requested.
+  unsigned long mLastLeftHandStatusPollTimeMs = 0;
+  bool mIsLeftHandStatusReportRequested = false;
+
+  // The LH uptime of the last status, and the ScanFrame time it was received; valid once a status was received.
+  uint16_t mLeftHandUptimeSeconds = 0;
+  unsigned long mLeftHandUptimeTimeMs = 0;
+  bool mIsLeftHandUptimeValid = false;
+
+#ifdef ENABLE_LH_DATA_READY_LINE
+  // The ScanFrame time of the last request to the LH Arduino.
+  unsigned long mLastLeftHandFetchTimeMs = 0;
+#endif
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+  // Set until the button flags are read from a snapshot; initially, and after any failed request.
+  bool mIsLeftHandSnapshotRequired = true;
+#endif
+
+#ifdef ENABLE_LH_FRAME_CHECK
+  // The generation of the last snapshot; valid once a snapshot was received.
+  uint8_t mLeftHandGeneration = 0;
+  bool mIsLeftHandGenerationValid = false;
+#endif
+#endif
 };
 
 #endif
@@ -0,0 +1,108 @@
+/*******************************************************************************
+  EventQueue.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+
+#ifndef EventQueue_H
+#define EventQueue_H
+
+#include <Arduino.h>
+
+// Prevents the compiler from moving memory accesses across this point; the AVR does not reorder them itself.
+#define COMPILER_MEMORY_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+// This class is a single-producer/single-consumer ring buffer of Events, e.g. ButtonEvents.
+// The producer only writes mHead, and the consumer only writes mTail, so neither side needs to disable interrupts,
+// whichever of them runs in an interrupt; e.g. TimerKeyScanner pushes from its timer interrupt, and loop() pops,
+// while on the LH Arduino, loop() pushes the button changes, and the TWI interrupt pops them into its reply.
+// Both sides may also run in loop(), as for MidiTransmitQueue. The indexes are single bytes, which the AVR reads and writes atomically.
+// Size must be a power of 2, no greater than 128; one slot is left unused to tell a full queue from an empty one.
+template <typename Event, uint8_t Size>
+class EventQueue
+{
+  static_assert(Size >= 2 && Size <= 128 && (Size & (Size - 1)) == 0, "EventQueue Size must be a power of 2, from 2 to 128.");
+
+public:
+  EventQueue()
+  {
+  }
+
+  // Called by the producer only. Returns false, and does not add the event, if the queue is full.
+  bool Push(const Event& event)
+  {
+    uint8_t head = mHead;
+    uint8_t nextHead = (head + 1) & IndexMask;
+    if (nextHead == mTail)
+    {
+      return false;
+    }
+
+    mEvents[head] = event;
+
+    // Publish the event only after it has been written.
+    COMPILER_MEMORY_BARRIER();
+    mHead = nextHead;
+    return true;
+  }
+
+  // Called by the consumer only. Returns false if the queue is empty.
+  bool Pop(Event& event)
+  {
+    uint8_t tail = mTail;
+    if (tail == mHead)
+    {
+      return false;
+    }
+
+    // Read the event only after its publication has been seen.
+    COMPILER_MEMORY_BARRIER();
+    event = mEvents[tail];
+
+    // Release the slot only after the event has been read.
+    COMPILER_MEMORY_BARRIER();
+    mTail = (tail + 1) & IndexMask;
+    return true;
+  }
+
+  // Called by the consumer only. Returns the oldest event, without removing it; the queue must not be empty.
+  const Event& Peek() { return mEvents[mTail]; }
+
+  bool IsEmpty() { return mTail == mHead; }
+
+  // Called by the consumer only. Returns the number of queued events; the producer may add more meanwhile.
+  uint8_t GetCount() { return (mHead - mTail) & IndexMask; }
+
+  // Called by the consumer only. Drops the queued events.
+  void Clear() { mTail = mHead; }
+
+private:
+  static const uint8_t IndexMask = Size - 1;
+
+  Event mEvents[Size];
+  volatile uint8_t mHead = 0;
+  volatile uint8_t mTail = 0;
+};
+
+#endif
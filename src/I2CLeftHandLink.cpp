@@ -0,0 +1,112 @@
+/*******************************************************************************
+  I2CLeftHandLink.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "MIDIAccordion.h"
+
+#if defined(BUILD_RIGHT_HAND_MASTER) && !defined(ENABLE_UART_LINK)
+
+#include <Wire.h>
+
+#include "I2CLeftHandLink.h"
+#include "SharedMacros.h"
+
+#ifdef ENABLE_ASYNC_I2C
+#include "TwiMaster.h"
+
+extern TwiMaster gTwiMaster;
+#endif
+
+I2CLeftHandLink::I2CLeftHandLink()
+{
+}
+
+void I2CLeftHandLink::Begin()
+{
+#ifdef ENABLE_ASYNC_I2C
+  gTwiMaster.Begin(I2CClockHz);
+#else
+  // Initiate the Wire library and join the I2C bus as a master.
+  Wire.begin();
+  Wire.setClock(I2CClockHz);
+#endif // ENABLE_ASYNC_I2C
+}
+
+bool I2CLeftHandLink::StartRequest(const uint8_t* commandBytes, uint8_t numCommandBytes, uint8_t numReplyBytes)
+{
+  // DBG_PRINT_LN("I2CLeftHandLink::StartRequest - Master requesting " + String(numReplyBytes) + " bytes from Slave1");
+#ifdef ENABLE_ASYNC_I2C
+  return gTwiMaster.StartTransfer(LeftHandI2CDeviceId, commandBytes, numCommandBytes, numReplyBytes);
+#else
+  mNumReplyBytes = 0;
+  mIsRequestFailed = false;
+  if (numCommandBytes > 0)
+  {
+    Wire.beginTransmission(LeftHandI2CDeviceId);
+    Wire.write(commandBytes, numCommandBytes);
+
+    // Keep the bus for the repeated start of the read, if any. A command not acknowledged fails, with or without reply bytes.
+    mIsRequestFailed = Wire.endTransmission(numReplyBytes == 0) != 0;
+    if (mIsRequestFailed || numReplyBytes == 0)
+    {
+      return true;
+    }
+  }
+
+  Wire.requestFrom((uint8_t)LeftHandI2CDeviceId, numReplyBytes);
+
+  while (Wire.available() != 0) { // slave may send less than requested
+    uint8_t receivedByte = Wire.read();
+    if (mNumReplyBytes < MaxLeftHandReplyBytes)
+    {
+      mReplyBytes[mNumReplyBytes++] = receivedByte;
+    }
+  }
+
+  return true;
+#endif // ENABLE_ASYNC_I2C
+}
+
+bool I2CLeftHandLink::PollReply(const uint8_t*& replyBytes, uint8_t& numReplyBytes, bool& isFailed)
+{
+#ifdef ENABLE_ASYNC_I2C
+  TwiMaster::Status status = gTwiMaster.Poll();
+  if (status == TwiMaster::TwiBusy)
+  {
+    return false;
+  }
+
+  replyBytes = gTwiMaster.GetReadBytes();
+  numReplyBytes = status == TwiMaster::TwiDone ? gTwiMaster.GetNumReadBytes() : 0;
+  isFailed = status != TwiMaster::TwiDone;
+#else
+  replyBytes = mReplyBytes;
+  numReplyBytes = mNumReplyBytes;
+  isFailed = mIsRequestFailed;
+#endif // ENABLE_ASYNC_I2C
+  return true;
+}
+
+#endif // BUILD_RIGHT_HAND_MASTER && !ENABLE_UART_LINK
@@ -0,0 +1,58 @@
+/*******************************************************************************
+  I2CLeftHandLink.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef I2CLeftHandLink_H
+#define I2CLeftHandLink_H
+
+#include <Arduino.h>
+
+#include "LeftHandLinkBase.h"
+#include "SharedConstants.h"
+
+// This class links the RH Arduino to the LH Arduino over I2C, as the master. The command bytes are written first, followed by a repeated start,
+// unless there are no reply bytes to read.
+// Without ENABLE_ASYNC_I2C, the Wire library completes each request before StartRequest() returns.
+// NOTE: Then, the slave must be connected to Master SDA and SCL lines, otherwise Master will freeze.
+// With ENABLE_ASYNC_I2C, the TwiMaster moves the bytes from its interrupt, and a request to a disconnected LH Arduino times out.
+class I2CLeftHandLink : public LeftHandLinkBase
+{
+public:
+  I2CLeftHandLink();
+
+  void Begin();
+  bool StartRequest(const uint8_t* commandBytes, uint8_t numCommandBytes, uint8_t numReplyBytes);
+  bool PollReply(const uint8_t*& replyBytes, uint8_t& numReplyBytes, bool& isFailed);
+
+private:
+#ifndef ENABLE_ASYNC_I2C
+  // The reply of the last request, read from the Wire library.
+  uint8_t mReplyBytes[MaxLeftHandReplyBytes];
+  uint8_t mNumReplyBytes = 0;
+  bool mIsRequestFailed = false;
+#endif
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*******************************************************************************
+  InputZone.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef InputZone_H
+#define InputZone_H
+
+#include <Arduino.h>
+
+#include "SharedConstants.h"
+
+class ButtonChangedHandlerBase;
+
+// The InputZone structure describes a range of buttons of a ButtonArray that share a button changed handler, and a debounce policy.
+// A table of InputZones, sorted by button index and not overlapping, is passed to ButtonsManager::ReadButtons(), which scans all
+// the zones in one pass, and passes each changed button straight to its zone's handler. Adding a zone adds no scanning work.
+typedef struct
+{
+  uint8_t firstButtonIndex;
+  uint8_t lastButtonIndex;
+  ButtonChangedHandlerBase* buttonChangedHandler;
+  DebouncePolicy debouncePolicy;
+} InputZone;
+
+// Returns the bitmap of the buttons in the zone passed in. Bit n of the bitmap corresponds to button index n.
+inline uint64_t GetInputZoneButtons(const InputZone& inputZone)
+{
+  // Shift in two steps, so that a zone of 64 buttons does not shift by 64.
+  return ((((uint64_t)1 << (inputZone.lastButtonIndex - inputZone.firstButtonIndex)) << 1) - 1) << inputZone.firstButtonIndex;
+}
+
+#endif
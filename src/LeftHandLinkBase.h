@@ -0,0 +1,55 @@
+/*******************************************************************************
+  LeftHandLinkBase.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef LeftHandLinkBase_H
+#define LeftHandLinkBase_H
+
+#include <Arduino.h>
+
+// This class is the interface of the RH Arduino to the link to the LH Arduino.
+// ButtonsManager fetches the LH button states, and configures the LH Arduino, with requests; the command bytes (a LeftHandI2CCommand,
+// and its value, or none without the delta protocol), and the number of reply bytes expected, which is 0 for a configuration command.
+// StartRequest() starts a request, and PollReply() returns its reply once complete.
+// Each implementation answers the requests the same way, so the fetch path does not depend on the transport.
+class LeftHandLinkBase
+{
+public:
+  // Starts the link. Called once by RightHandSetupManager.
+  virtual void Begin() = 0;
+
+  // Starts a request. Returns false if a request is still in progress; the request should then be started again later.
+  virtual bool StartRequest(const uint8_t* commandBytes, uint8_t numCommandBytes, uint8_t numReplyBytes) = 0;
+
+  // Returns true once the request has completed, with its reply bytes; a failed request has no reply bytes, and sets isFailed,
+  // so that the failure of a command without reply bytes is not lost. Returns false while the request is in progress.
+  virtual bool PollReply(const uint8_t*& replyBytes, uint8_t& numReplyBytes, bool& isFailed) = 0;
+
+protected:
+  // The default constructor is protected to prevent its usage.
+  LeftHandLinkBase() {}
+};
+
+#endif
@@ -40,6 +40,52 @@
 // #define MAX_MIDI_VOLUME_WHEN_BELLOWS_IS_CLOSED
 
 #define ENABLE_CUSTOM_PROGRAM_CHANGE_BUTTONS
+
+// Comment out to read buttons with one digitalRead() per button, instead of reading whole AVR port input registers.
+#define ENABLE_PORT_REGISTER_SCAN
+
+// Uncomment to sample the RH keys from a timer interrupt at a fixed rate, independent of the loop() time. Requires ENABLE_PORT_REGISTER_SCAN.
+// #define ENABLE_TIMER_KEY_SCAN
+
+// Uncomment to capture the edges of the RH keys on Port B with pin change interrupts, between scans. Requires ENABLE_PORT_REGISTER_SCAN.
+// #define ENABLE_PIN_CHANGE_CAPTURE
+
+// Uncomment to send only the LH button changes over I2C, instead of all the LH button flags on every request. Build both Arduinos with the same setting.
+// #define ENABLE_I2C_DELTA_PROTOCOL
+
+// Uncomment to request the LH button states only when the LH Arduino signals a change on LeftHandDataReadyPin, and on a slow keep-alive poll.
+// Build both Arduinos with the same setting, and wire LeftHandDataReadyPin of both Arduinos together.
+// #define ENABLE_LH_DATA_READY_LINE
+
+// Uncomment to fetch the LH button states with the interrupt driven TwiMaster, instead of the Wire library, on the RH Arduino.
+// loop() then does not wait for I2C transfers, and a disconnected LH Arduino times out, instead of freezing the RH Arduino.
+// #define ENABLE_ASYNC_I2C
+
+// Uncomment to add a generation byte, and a CRC-8, to the LH replies; the RH Arduino discards corrupted replies, and skips unchanged snapshots.
+// Build both Arduinos with the same setting.
+// #define ENABLE_LH_FRAME_CHECK
+
+// Uncomment to debounce the LH buttons on the LH Arduino, at its scan rate, and send only debounced button states;
+// the RH Arduino then applies the LH button states as received. Build both Arduinos with the same setting.
+// #define ENABLE_LH_SLAVE_DEBOUNCE
+
+// Uncomment to link the Arduinos with framed UART messages on Serial2 (TX2 pin 16, RX2 pin 17, crossed over), at LeftHandLinkBaudRate,
+// instead of I2C. The LH Arduino then sends its button changes without being polled. Build both Arduinos with the same setting.
+// #define ENABLE_UART_LINK
+
+// Uncomment to send MIDI with running status; repeated status bytes, e.g. of a chord's notes, are omitted.
+// The status byte is sent again after other traffic, and at least every MidiRunningStatusRefreshMs.
+// #define ENABLE_MIDI_RUNNING_STATUS
+
+// Uncomment to send releases as Note On with velocity 0, instead of Note Off; then, with ENABLE_MIDI_RUNNING_STATUS,
+// the Note Ons and Note Offs of a channel share one running status, e.g. a chord change is one status byte and the note pairs.
+// #define ENABLE_NOTE_OFF_AS_VELOCITY_ZERO
+
+// Uncomment to queue the MIDI messages of the RH Arduino, and write them only while they fit in the Serial TX buffer; so loop() rarely
+// waits for the MIDI out. Notes, program changes, and discrete control changes are sent in order, then the latest value of each continuous control,
+// never ahead of a later message of its MIDI channel; see MidiTransmitQueue.
+// #define ENABLE_MIDI_TRANSMIT_QUEUE
+
 // #define DISABLE_I2C
 // #define DISABLE_SENSOR_READS
 #define IGNORE_BELLOWS_VOLUME
@@ -0,0 +1,115 @@
+/*******************************************************************************
+  MidiBandwidthMeter.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "MIDIAccordion.h"
+
+#ifdef BUILD_RIGHT_HAND_MASTER
+
+#include "lib/ArduMidi/ardumidi.h"
+
+#include "MidiBandwidthMeter.h"
+
+// The average is kept over at most this time, about 17 minutes; then the totals are halved, so the products below do not overflow.
+static const unsigned long MaxTotalElapsedMs = 0x000FFFFF;
+
+// The Serial TX buffer is 64 bytes by default; the MIDI out is busy while less than half of it is free.
+static const uint8_t MinFreeTxBytes = 32;
+
+MidiBandwidthMeter::MidiBandwidthMeter()
+{
+}
+
+void MidiBandwidthMeter::Update(unsigned long curTimeMs)
+{
+  unsigned long elapsedMs = curTimeMs - mWindowStartTimeMs;
+  if (elapsedMs < MidiBandwidthWindowMs)
+  {
+    return;
+  }
+
+  // A window may be longer if loop() was slow; its utilization is then measured over its whole length.
+  unsigned long totalBytesSent = midi_get_total_bytes_sent();
+  unsigned long numBytes = totalBytesSent - mWindowStartBytes;
+  mWindowStartTimeMs = curTimeMs;
+  mWindowStartBytes = totalBytesSent;
+  if (elapsedMs > MaxTotalElapsedMs)
+  {
+    // loop() stalled; the window is left out.
+    return;
+  }
+
+  mLastWindowUtilizationPercent = GetUtilizationPercent(numBytes, elapsedMs);
+  if (mLastWindowUtilizationPercent > mPeakUtilizationPercent)
+  {
+    mPeakUtilizationPercent = mLastWindowUtilizationPercent;
+  }
+
+  if (mTotalElapsedMs + elapsedMs > MaxTotalElapsedMs)
+  {
+    mTotalBytes /= 2;
+    mTotalElapsedMs /= 2;
+  }
+
+  mTotalBytes += numBytes;
+  mTotalElapsedMs += elapsedMs;
+}
+
+bool MidiBandwidthMeter::IsBusy()
+{
+  return mLastWindowUtilizationPercent >= MidiBandwidthBusyPercent || Serial.availableForWrite() < MinFreeTxBytes;
+}
+
+void MidiBandwidthMeter::LogBackOff()
+{
+  if (mNumBackOffs < 0xFFFF)
+  {
+    mNumBackOffs++;
+  }
+}
+
+// The statistics restart from the current window; the last window's utilization, used by IsBusy(), is kept.
+void MidiBandwidthMeter::ResetStatistics()
+{
+  mPeakUtilizationPercent = mLastWindowUtilizationPercent;
+  mTotalBytes = 0;
+  mTotalElapsedMs = 0;
+  mNumBackOffs = 0;
+}
+
+// Returns the bytes passed in as a percentage of the bytes the MIDI out sends in the time passed in; saturates at 255.
+uint8_t MidiBandwidthMeter::GetUtilizationPercent(unsigned long numBytes, unsigned long elapsedMs)
+{
+  unsigned long capacityBytes = elapsedMs * MidiBytesPerSecond / 1000;
+  if (capacityBytes == 0)
+  {
+    return 0;
+  }
+
+  unsigned long percent = numBytes * 100 / capacityBytes;
+  return percent < 0xFF ? percent : 0xFF;
+}
+
+#endif // BUILD_RIGHT_HAND_MASTER
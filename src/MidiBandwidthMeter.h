@@ -0,0 +1,72 @@
+/*******************************************************************************
+  MidiBandwidthMeter.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef MidiBandwidthMeter_H
+#define MidiBandwidthMeter_H
+
+#include <Arduino.h>
+
+#include "SharedConstants.h"
+
+// This class measures the MIDI out utilization; the bytes written by ArduMidi per MidiBandwidthWindowMs window, as a percentage of
+// the bytes the MIDI out sends in that time. It keeps the last window's, the peak, and the average utilization, and signals when the
+// MIDI out is busy; producers of continuous controllers, e.g. VolumeChangeManager, then back off, and send their latest value once
+// it is not. The bytes are counted as written to the Serial TX buffer, so a window may exceed 100% while the buffer fills.
+class MidiBandwidthMeter
+{
+public:
+  MidiBandwidthMeter();
+
+  // Closes the window once MidiBandwidthWindowMs elapsed. Called by loop().
+  void Update(unsigned long curTimeMs);
+
+  // Returns true if the last window used at least MidiBandwidthBusyPercent of the bandwidth, or the Serial TX buffer is half full.
+  bool IsBusy();
+
+  // Called by a producer that did not send a message because the MIDI out was busy.
+  void LogBackOff();
+
+  uint8_t GetLastWindowUtilizationPercent() { return mLastWindowUtilizationPercent; }
+  uint8_t GetPeakUtilizationPercent() { return mPeakUtilizationPercent; }
+  uint8_t GetAverageUtilizationPercent() { return GetUtilizationPercent(mTotalBytes, mTotalElapsedMs); }
+  uint16_t GetNumBackOffs() { return mNumBackOffs; }
+
+  void ResetStatistics();
+
+protected:
+  static uint8_t GetUtilizationPercent(unsigned long numBytes, unsigned long elapsedMs);
+
+private:
+  unsigned long mWindowStartTimeMs = 0;
+  unsigned long mWindowStartBytes = 0;
+  uint8_t mLastWindowUtilizationPercent = 0;
+  uint8_t mPeakUtilizationPercent = 0;
+  unsigned long mTotalBytes = 0;
+  unsigned long mTotalElapsedMs = 0;
+  uint16_t mNumBackOffs = 0;
+};
+
+#endif
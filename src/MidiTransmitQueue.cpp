@@ -0,0 +1,238 @@
+/*******************************************************************************
+  MidiTransmitQueue.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "MIDIAccordion.h"
+
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_MIDI_TRANSMIT_QUEUE)
+
+#include "lib/ArduMidi/ardumidi.h"
+
+#include "MidiTransmitQueue.h"
+
+extern MidiTransmitQueue gMidiTransmitQueue;
+
+// The continuous controllers, whose pending value may be replaced by a later one; Channel Volume, and Expression.
+static const uint8_t ChannelVolumeController = 0x07;
+static const uint8_t ExpressionController = 0x0B;
+
+MidiTransmitQueue::MidiTransmitQueue()
+{
+  ResetStatistics();
+}
+
+void MidiTransmitQueue::Begin()
+{
+  midi_set_message_sink(OnMidiMessage);
+}
+
+void MidiTransmitQueue::Enqueue(uint8_t status, uint8_t data1, uint8_t data2, uint8_t numDataBytes)
+{
+  MidiTransmitPriority priority = GetPriority(status, data1);
+  MidiTransmitMessage message = {status, data1, data2, numDataBytes};
+  bool isAdded = true;
+  if (priority == MidiControlChangePriority)
+  {
+    isAdded = EnqueueControlChange(message);
+  }
+  else
+  {
+    EnqueueNote(message);
+  }
+
+  Update();
+
+  // The messages of a priority are written oldest first; so the message added is still queued if any message of its priority is.
+  if (isAdded && mNumDeferredMessages < 0xFFFF)
+  {
+    bool isPending = (priority == MidiControlChangePriority) ? (mNumControlChanges > 0) : !mNoteQueue.IsEmpty();
+    if (isPending)
+    {
+      mNumDeferredMessages++;
+    }
+  }
+}
+
+// The pending control changes of the message's MIDI channel are queued ahead of it.
+void MidiTransmitQueue::EnqueueNote(const MidiTransmitMessage& message)
+{
+  MoveControlChangesToNoteQueue(message.status & 0x0F);
+  PushNote(message);
+}
+
+// If the note queue is full, its oldest message is written to make room; Serial.write() then waits for the TX buffer,
+// rather than a Note Off being lost.
+void MidiTransmitQueue::PushNote(const MidiTransmitMessage& message)
+{
+  while (!mNoteQueue.Push(message))
+  {
+    MidiTransmitMessage oldestMessage;
+    mNoteQueue.Pop(oldestMessage);
+    midi_write_message(oldestMessage.status, oldestMessage.data1, oldestMessage.data2, oldestMessage.numDataBytes);
+    if (mNumBlockingWrites < 0xFFFF)
+    {
+      mNumBlockingWrites++;
+    }
+  }
+
+  uint8_t count = mNoteQueue.GetCount();
+  if (count > mHighWaterMarks[MidiNotePriority])
+  {
+    mHighWaterMarks[MidiNotePriority] = count;
+  }
+}
+
+// A pending control change of the same control takes the value passed in; otherwise, the control change is added last.
+// If there is no room for it, it is queued with the notes instead, in order, and not coalesced.
+// Returns true if the control change was added.
+bool MidiTransmitQueue::EnqueueControlChange(const MidiTransmitMessage& message)
+{
+  for (uint8_t i = 0; i < mNumControlChanges; i++)
+  {
+    if (IsSameControl(mControlChanges[i], message))
+    {
+      mControlChanges[i] = message;
+      if (mNumCoalescedControlChanges < 0xFFFF)
+      {
+        mNumCoalescedControlChanges++;
+      }
+      return false;
+    }
+  }
+
+  if (mNumControlChanges == MaxPendingControlChanges)
+  {
+    EnqueueNote(message);
+    return true;
+  }
+
+  mControlChanges[mNumControlChanges++] = message;
+  if (mNumControlChanges > mHighWaterMarks[MidiControlChangePriority])
+  {
+    mHighWaterMarks[MidiControlChangePriority] = mNumControlChanges;
+  }
+
+  return true;
+}
+
+// Moves the pending control changes of the MIDI channel passed in to the note queue, oldest first; the others keep their order.
+void MidiTransmitQueue::MoveControlChangesToNoteQueue(uint8_t channel)
+{
+  uint8_t numKept = 0;
+  for (uint8_t i = 0; i < mNumControlChanges; i++)
+  {
+    const MidiTransmitMessage& controlChange = mControlChanges[i];
+    if ((controlChange.status & 0x0F) != channel)
+    {
+      mControlChanges[numKept++] = controlChange;
+      continue;
+    }
+
+    PushNote(controlChange);
+  }
+
+  mNumControlChanges = numKept;
+}
+
+// A control change message is keyed by its status byte, i.e. type and MIDI channel, and controller number;
+// channel pressure, and pitch bend, have no controller number.
+bool MidiTransmitQueue::IsSameControl(const MidiTransmitMessage& message, const MidiTransmitMessage& otherMessage)
+{
+  if (message.status != otherMessage.status)
+  {
+    return false;
+  }
+
+  return (message.status & 0xF0) != MIDI_CONTROLLER_CHANGE || message.data1 == otherMessage.data1;
+}
+
+// A whole message is written only if it fits; Serial.write() would otherwise wait for the TX buffer.
+// Nothing is queued meanwhile, so the notes, then the control changes, are written in turn.
+void MidiTransmitQueue::Update()
+{
+  while (!mNoteQueue.IsEmpty())
+  {
+    if (Serial.availableForWrite() < MaxMidiMessageBytes)
+    {
+      return;
+    }
+
+    MidiTransmitMessage message;
+    mNoteQueue.Pop(message);
+    midi_write_message(message.status, message.data1, message.data2, message.numDataBytes);
+  }
+
+  uint8_t numWritten = 0;
+  while (numWritten < mNumControlChanges && Serial.availableForWrite() >= MidiControlChangeMinFreeTxBytes)
+  {
+    const MidiTransmitMessage& message = mControlChanges[numWritten++];
+    midi_write_message(message.status, message.data1, message.data2, message.numDataBytes);
+  }
+
+  // Keep the unwritten control changes, oldest first.
+  for (uint8_t i = numWritten; i < mNumControlChanges; i++)
+  {
+    mControlChanges[i - numWritten] = mControlChanges[i];
+  }
+
+  mNumControlChanges -= numWritten;
+}
+
+void MidiTransmitQueue::ResetStatistics()
+{
+  for (uint8_t i = 0; i < NumMidiTransmitPriorities; i++)
+  {
+    mHighWaterMarks[i] = 0;
+  }
+
+  mNumBlockingWrites = 0;
+  mNumCoalescedControlChanges = 0;
+  mNumDeferredMessages = 0;
+}
+
+// Only the continuous controls are coalesced; Channel Volume, Expression, channel pressure, and pitch bend. The other messages,
+// e.g. Sustain, Bank Select, the channel mode messages, and program changes, are sent in order with the notes.
+MidiTransmitPriority MidiTransmitQueue::GetPriority(uint8_t status, uint8_t data1)
+{
+  switch (status & 0xF0)
+  {
+    case MIDI_CONTROLLER_CHANGE:
+      return (data1 == ChannelVolumeController || data1 == ExpressionController) ? MidiControlChangePriority : MidiNotePriority;
+
+    case MIDI_CHANNEL_PRESSURE:
+    case MIDI_PITCH_BEND:
+      return MidiControlChangePriority;
+
+    default:
+      return MidiNotePriority;
+  }
+}
+
+void MidiTransmitQueue::OnMidiMessage(byte status, byte data1, byte data2, byte numDataBytes)
+{
+  gMidiTransmitQueue.Enqueue(status, data1, data2, numDataBytes);
+}
+
+#endif // BUILD_RIGHT_HAND_MASTER && ENABLE_MIDI_TRANSMIT_QUEUE
@@ -0,0 +1,125 @@
+/*******************************************************************************
+  MidiTransmitQueue.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef MidiTransmitQueue_H
+#define MidiTransmitQueue_H
+
+#include <Arduino.h>
+
+#include "EventQueue.h"
+#include "SharedConstants.h"
+
+// The priorities of the MIDI messages; the queued messages of a higher priority, i.e. lower value, are sent first,
+// except that a message never overtakes one of the same MIDI channel queued before it.
+enum MidiTransmitPriority : uint8_t
+{
+  // Notes, program changes, and the control changes not coalesced, e.g. All Notes Off; sent in the order they were queued.
+  MidiNotePriority,
+
+  // Channel Volume, Expression, channel pressure, and pitch bend; coalesced.
+  MidiControlChangePriority,
+  NumMidiTransmitPriorities
+};
+
+// A MIDI channel message; the status byte, and 1 or 2 data bytes.
+struct MidiTransmitMessage
+{
+  uint8_t status;
+  uint8_t data1;
+  uint8_t data2;
+  uint8_t numDataBytes;
+};
+
+// This class queues the MIDI channel messages of ArduMidi, and writes them to Serial only while they fit in its TX buffer,
+// which the HardwareSerial interrupt drains; so sending MIDI rarely blocks loop(), e.g. during a Panic.
+// The HardwareSerial library owns the data register empty interrupt, so the queue is drained by Update(), from loop(), instead.
+// Notes, program changes, and the channel mode, and other discrete, control changes share one queue, so they are sent in the order
+// they were queued; e.g. a note played after a Panic is never silenced by its All Notes Off, and a note after a program change sounds
+// on the new patch. The continuous controls, Channel Volume, Expression, channel pressure, and pitch bend, are coalesced instead;
+// a pending one of the same MIDI channel and controller (or of the same status, for channel pressure and pitch bend) takes the latest
+// value, and keeps its place. They are written only while the TX buffer
+// has spare capacity, so a fast volume sweep never delays notes, and only its latest values are sent. Before a note of a MIDI
+// channel is queued, the pending control changes of that channel are moved to the note queue, so they are not overtaken by it.
+// No message is dropped; if the note queue is full, its oldest message is written, waiting for the TX buffer if need be.
+// Running status is applied as the messages are written.
+class MidiTransmitQueue
+{
+public:
+  MidiTransmitQueue();
+
+  // Routes the ArduMidi channel messages to this queue. Called by RightHandSetupManager once Serial is started.
+  void Begin();
+
+  // Queues the message passed in, and writes what fits.
+  void Enqueue(uint8_t status, uint8_t data1, uint8_t data2, uint8_t numDataBytes);
+
+  // Writes the queued messages, notes first, while they fit in the Serial TX buffer. Called by loop().
+  void Update();
+
+  // The most messages queued at once, of each priority, since the statistics were reset.
+  uint8_t GetHighWaterMark(MidiTransmitPriority priority) { return mHighWaterMarks[priority]; }
+
+  // The number of messages written while the note queue was full, which may have waited for the TX buffer.
+  uint16_t GetNumBlockingWrites() { return mNumBlockingWrites; }
+
+  // The number of control changes whose value was replaced before being sent.
+  uint16_t GetNumCoalescedControlChanges() { return mNumCoalescedControlChanges; }
+
+  // The number of messages queued, and not written at once, because the Serial TX buffer was full; the MIDI out was busy.
+  uint16_t GetNumDeferredMessages() { return mNumDeferredMessages; }
+
+  // Returns true if no message is waiting to be written.
+  bool IsIdle() { return mNoteQueue.IsEmpty() && mNumControlChanges == 0; }
+
+  void ResetStatistics();
+
+  static MidiTransmitPriority GetPriority(uint8_t status, uint8_t data1);
+
+protected:
+  void EnqueueNote(const MidiTransmitMessage& message);
+  void PushNote(const MidiTransmitMessage& message);
+  bool EnqueueControlChange(const MidiTransmitMessage& message);
+  void MoveControlChangesToNoteQueue(uint8_t channel);
+  static bool IsSameControl(const MidiTransmitMessage& message, const MidiTransmitMessage& otherMessage);
+
+private:
+  // The ArduMidi message sink; queues the message in gMidiTransmitQueue.
+  static void OnMidiMessage(byte status, byte data1, byte data2, byte numDataBytes);
+
+  // The notes, program changes, and control changes not coalesced, in order.
+  EventQueue<MidiTransmitMessage, MidiTransmitQueueSize> mNoteQueue;
+
+  // The pending control changes, oldest first.
+  MidiTransmitMessage mControlChanges[MaxPendingControlChanges];
+  uint8_t mNumControlChanges = 0;
+
+  uint8_t mHighWaterMarks[NumMidiTransmitPriorities];
+  uint16_t mNumBlockingWrites;
+  uint16_t mNumCoalescedControlChanges;
+  uint16_t mNumDeferredMessages;
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*******************************************************************************
+  PinChangeCapture.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+
+#include "MIDIAccordion.h"
+
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_PIN_CHANGE_CAPTURE)
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "PinChangeCapture.h"
+
+PinChangeCapture* PinChangeCapture::spStartedInstance = NULL;
+
+ISR(PCINT0_vect)
+{
+  PinChangeCapture::OnPinChange();
+}
+
+PinChangeCapture::PinChangeCapture(uint8_t pinChangeMask) :
+  mPinChangeMask(pinChangeMask)
+{
+}
+
+void PinChangeCapture::Start()
+{
+  noInterrupts();
+
+  spStartedInstance = this;
+
+  // PCINT0-7 are the bits of Port B.
+  PCMSK0 = mPinChangeMask;
+  PCIFR = _BV(PCIF0);
+  PCICR |= _BV(PCIE0);
+
+  interrupts();
+}
+
+void PinChangeCapture::OnPinChange()
+{
+  PortSnapshot snapshot;
+  snapshot.portValue = PINB;
+  snapshot.timeMicroseconds = micros();
+
+  spStartedInstance->mSnapshotQueue.Push(snapshot);
+}
+
+#endif // BUILD_RIGHT_HAND_MASTER && ENABLE_PIN_CHANGE_CAPTURE
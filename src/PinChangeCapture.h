@@ -0,0 +1,144 @@
+/*******************************************************************************
+  PinChangeCapture.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+
+#ifndef PinChangeCapture_H
+#define PinChangeCapture_H
+
+#include <Arduino.h>
+
+#include "MIDIAccordion.h"
+
+#ifndef ENABLE_PORT_REGISTER_SCAN
+  #error "ENABLE_PIN_CHANGE_CAPTURE requires ENABLE_PORT_REGISTER_SCAN."
+#endif
+
+#ifdef ENABLE_TIMER_KEY_SCAN
+  #error "ENABLE_PIN_CHANGE_CAPTURE and ENABLE_TIMER_KEY_SCAN cannot both be defined; the timer interrupt already samples the keys between loop() iterations."
+#endif
+
+#include "ButtonLayout.h"
+#include "EventQueue.h"
+#include "SharedConstants.h"
+
+// The PortSnapshot structure contains the value of a port input register, and the micros() time it was read.
+typedef struct
+{
+  uint8_t portValue;
+  unsigned long timeMicroseconds;
+} PortSnapshot;
+
+// This abstract class captures the edges of a bank of buttons between scans, with the AVR pin change interrupt of Port B (PCINT0).
+// On each edge, the interrupt queues a snapshot of PINB and micros(); ButtonsManager::ReadButtons() reconciles the queued snapshots
+// with its polled state, so that a press is seen even if the button was released again before the scan (e.g. while loop()
+// was blocked by I2C or analogRead()), and is timestamped with the time of its edge, rather than the time of the scan.
+// Port B is the only port with pin change interrupts that carries RH buttons; Ports A, C, and L have none.
+class PinChangeCapture
+{
+public:
+  PinChangeCapture(uint8_t pinChangeMask);
+
+  // Enables the pin change interrupt of the bank's Port B pins.
+  void Start();
+
+  // Returns the bitmap of buttons, not in activeButtons, that were captured pressed since the last call.
+  // firstPressTimeMicroseconds is set to the time of the first of those presses; it is unchanged if there were none.
+  virtual uint64_t ReadCapturedPresses(uint64_t activeButtons, unsigned long& firstPressTimeMicroseconds) = 0;
+
+  // Called by the pin change interrupt only.
+  static void OnPinChange();
+
+protected:
+  // The default constructor is protected to prevent its usage.
+  PinChangeCapture();
+
+  bool PopSnapshot(PortSnapshot& snapshot) { return mSnapshotQueue.Pop(snapshot); }
+
+private:
+  // The instance started by Start(); there is one PCINT0 interrupt.
+  static PinChangeCapture* spStartedInstance;
+
+  uint8_t mPinChangeMask;
+
+  // If the queue is full, snapshots are dropped; the buttons are then still read by the scan.
+  EventQueue<PortSnapshot, PinChangeSnapshotQueueSize> mSnapshotQueue;
+};
+
+// This class captures the edges of the buttons of bank, Bank, of the ButtonLayout that are on Port B.
+// The pin change mask, and the mapping from port bits to button indexes, are resolved at compile time.
+template <class ButtonLayout, ButtonBank Bank>
+class ButtonBankPinChangeCapture : public PinChangeCapture
+{
+public:
+  static const uint8_t FirstButtonIndex = GetBankFirstButtonIndex(Bank);
+  static const uint8_t NumButtons = GetBankNumButtons(Bank);
+  static const uint8_t PinChangeMask = ButtonPortBitMask<ButtonLayout, FirstButtonIndex, NumButtons, PortB>::Value;
+
+  static_assert(PinChangeMask != 0, "None of the buttons of the bank are on Port B.");
+
+public:
+  ButtonBankPinChangeCapture() : PinChangeCapture(PinChangeMask)
+  {
+  }
+
+  virtual uint64_t ReadCapturedPresses(uint64_t activeButtons, unsigned long& firstPressTimeMicroseconds)
+  {
+    // Buttons on other ports read as released.
+    uint8_t portValues[NumMegaPorts];
+    for (uint8_t port = 0; port < NumMegaPorts; port++)
+    {
+      portValues[port] = 0xFF;
+    }
+
+    uint64_t capturedPresses = 0;
+    PortSnapshot snapshot;
+    while (PopSnapshot(snapshot))
+    {
+      portValues[PortB] = snapshot.portValue;
+
+      union
+      {
+        uint64_t bitmap;
+        uint8_t bytes[8];
+      } pressedButtons;
+
+      pressedButtons.bitmap = 0;
+      ButtonGather<ButtonLayout, FirstButtonIndex, NumButtons>::Gather(portValues, pressedButtons.bytes);
+
+      uint64_t newPresses = pressedButtons.bitmap & ~activeButtons;
+      if (capturedPresses == 0 && newPresses != 0)
+      {
+        firstPressTimeMicroseconds = snapshot.timeMicroseconds;
+      }
+
+      capturedPresses |= newPresses;
+    }
+
+    return capturedPresses;
+  }
+};
+
+#endif
@@ -0,0 +1,79 @@
+/*******************************************************************************
+  ScanFrame.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef ScanFrame_H
+#define ScanFrame_H
+
+#include <Arduino.h>
+
+#include "SharedConstants.h"
+#include "ButtonEvent.h"
+#include "Sensor.h"
+
+class ButtonArray;
+class ButtonChangedHandlerBase;
+class SensorChangedHandlerBase;
+
+// The ScanFrameButtonEvent structure is a button event of a ScanFrame, with the ButtonArray and handler it is dispatched to.
+typedef struct
+{
+  ButtonEvent buttonEvent;
+  ButtonArray* buttons;
+  ButtonChangedHandlerBase* buttonChangedHandler;
+} ScanFrameButtonEvent;
+
+// The ScanFrame structure holds everything the input paths read during one pass of loop().
+// It is started by ButtonsManager::BeginScanFrame(), which samples the clock once; every input path uses that time
+// instead of calling millis() or micros() itself. The button and sensor changes are collected, and passed to their
+// handlers in the order they were read; the RH button events by ButtonsManager::DispatchButtonEvents(), once the RH
+// buttons are read, and the LH button events, then the sensor changes, by ButtonsManager::EndScanFrame().
+typedef struct
+{
+  // The millis() and micros() time the frame was started.
+  unsigned long timeMs;
+  unsigned long timeMicroseconds;
+
+  // The buttons read pressed this frame by the ButtonsManager::ReadButtons() methods, one bit per button index.
+  uint64_t pressedButtons;
+
+  // The LH bank flags received from the LH Arduino this frame, in bank order, from FirstLeftHandButtonBank. Only used by the RH Arduino.
+  uint16_t leftHandButtonFlags[NumLeftHandButtonBanks];
+
+  // The sensors read this frame, and one bit per sensor whose value changed.
+  Sensor* sensors;
+  SensorChangedHandlerBase* sensorChangedHandler;
+  uint8_t changedSensors;
+
+  // The button events not yet dispatched, and the number of button events added this frame, including those dispatched early.
+  uint8_t numButtonEvents;
+  uint8_t totalButtonEvents;
+  ScanFrameButtonEvent buttonEvents[MaxScanFrameButtonEvents];
+} ScanFrame;
+
+// changedSensors has one bit per sensor.
+static_assert(NumRightHandSensors <= 8, "ScanFrame.changedSensors has fewer bits than there are sensors.");
+
+#endif
@@ -24,23 +24,108 @@
   
  ******************************************************************************/
 
+#include "../MIDIAccordion.h"
+
+// The LH Arduino is the only I2C slave; see RightHandSetupManager for the master.
+#ifdef BUILD_LEFT_HAND_SLAVE
+
 #include <Wire.h>
 
 #include "../SharedConstants.h"
+#include "../EventQueue.h"
 #include "LeftHandSetupManager.h"
+#ifdef ENABLE_PORT_REGISTER_SCAN
+#include "../ButtonPortScanner.h"
+#endif
+#ifdef ENABLE_UART_LINK
+#include "../UartLeftHandLink.h"
+#endif
 #include "../SharedMacros.h"
 #include "../Utilities/Utilities.h"
 
 // Global External Variables
-extern Button leftHandButtons[NumLeftHandButtons];
+extern ButtonArrayOf<NumLeftHandButtons> leftHandButtons;
+#ifdef ENABLE_PORT_REGISTER_SCAN
+extern ButtonLayoutScanner<LeftHandButtonLayout> leftHandButtonPortScanner;
+#endif
 
 // Global Variables
 uint16_t gBassButtonFlags = 0;
 uint16_t gChordButtonFlags = 0;
 uint16_t gToneButtonFlags = 0;
 
-// Local File Variable
-static int sCurrentMessageIndex = 0;
+#ifdef ENABLE_LH_FRAME_CHECK
+// The snapshot reply is the generation, the button flags, and the CRC-8 of both.
+static const uint8_t NumSnapshotReplyBytes = NumBytesExpectedFromLeftHandArduino + LeftHandSnapshotCheckNumBytes;
+
+// Incremented each time a snapshot is published; the RH Arduino skips snapshots of the same generation.
+static uint8_t sFrameGeneration = 0;
+#else
+static const uint8_t NumSnapshotReplyBytes = NumBytesExpectedFromLeftHandArduino;
+#endif
+
+// The snapshot replies; loop() writes the one that is not published, and then publishes it by flipping sPublishedSnapshotIndex.
+// The I2C interrupt only copies the published reply.
+static uint8_t sSnapshotReplies[2][NumSnapshotReplyBytes];
+static volatile uint8_t sPublishedSnapshotIndex = 0;
+
+#ifdef ENABLE_LH_FRAME_CHECK
+static const uint8_t NumStatusReplyBytes = NumLeftHandStatusBytes + LeftHandStatusCheckNumBytes;
+#else
+static const uint8_t NumStatusReplyBytes = NumLeftHandStatusBytes;
+#endif
+
+// The status replies, published by PublishStatus() the same way as the snapshot replies.
+static uint8_t sStatusReplies[2][NumStatusReplyBytes];
+static volatile uint8_t sPublishedStatusIndex = 0;
+
+// The configuration set by the RH Arduino.
+static uint16_t sScanIntervalMicroseconds = LeftHandScanIntervalMicroseconds;
+
+// The micros() time the current scan started.
+static unsigned long sScanStartTimeMicroseconds = 0;
+
+// The scan statistics of the current window, and of the last complete window, which is reported.
+static unsigned long sScanStatsWindowStartTimeMs = 0;
+static uint16_t sNumScans = 0;
+static uint32_t sTotalScanTimeMicroseconds = 0;
+static uint16_t sMaxScanTimeMicroseconds = 0;
+static uint16_t sLastWindowNumScans = 0;
+static uint16_t sLastWindowAverageScanTimeMicroseconds = 0;
+static uint16_t sLastWindowMaxScanTimeMicroseconds = 0;
+
+// The last command written by the RH Arduino, other than a configuration command. Without the delta protocol, the RH Arduino
+// writes no command before reading a snapshot.
+static volatile uint8_t sCommand = ReadLeftHandSnapshot;
+
+// A configuration command written by the RH Arduino, and its value.
+struct LeftHandCommand
+{
+  uint8_t bytes[MaxLeftHandCommandBytes];
+  uint8_t numBytes;
+};
+
+// The configuration commands written by the RH Arduino, in order, handled by loop(); see HandleMasterCommands().
+// The TWI interrupt pushes them, and loop() pops them.
+static EventQueue<LeftHandCommand, LeftHandCommandQueueSize> sPendingCommands;
+
+#ifdef ENABLE_UART_LINK
+// The millis() time the last snapshot frame was sent.
+static unsigned long sLastSnapshotFrameTimeMs = 0;
+
+// Parses the command frames sent by the RH Arduino.
+static UartLinkFrameParser sUartLinkFrameParser;
+#endif
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+LeftHandButtonEventQueue gLeftHandButtonEventQueue;
+
+// Set when a button event could not be queued; the RH Arduino then reads a snapshot of the button flags.
+volatile bool gIsLeftHandSnapshotRequired = true;
+
+// The number of button events of the last ReadLeftHandEventCount reply.
+static uint8_t sNumReportedButtonEvents = 0;
+#endif // ENABLE_I2C_DELTA_PROTOCOL
 
 // // Forward declarations
 // void OnDataRequestedByMaster();
@@ -74,29 +159,47 @@ void LeftHandSetupManager::Setup()
   int numButtons = GetNumButtons();
   for (char i = 0; i < numButtons; i++)
   {
-    pinMode(GetButtonAt(i).buttonState.pin, INPUT_PULLUP);
+    // The button pins come from the pin map in ButtonLayout.h.
+    pinMode(GetButtons().GetPin(i), INPUT_PULLUP);
   }
 
-  Wire.onRequest(OnDataRequestedByMaster); // register event to handle Master's request for slave data.
+#ifdef ENABLE_UART_LINK
+  UART_LINK_SERIAL.begin(LeftHandLinkBaudRate);
+#endif
+
+  // Publish the initial button states, and status, before the RH Arduino may request them.
+  PublishSnapshot();
+  PublishStatus(millis());
+
+#ifdef ENABLE_LH_DATA_READY_LINE
+  // Signal data ready, so that the RH Arduino reads the initial button states.
+  pinMode(LeftHandDataReadyPin, OUTPUT);
+  SetDataReady();
+#endif
 
+#ifdef ENABLE_UART_LINK
+  // The RH Arduino is sent the initial button states, and then each change.
+  SendSnapshotFrame();
+#else
   DBG_PRINT_LN("LeftHandSetup::Setup() - Starting I2C.");
 
   // Setup I2C
   Wire.begin(LeftHandI2CDeviceId);      // join i2c bus with address #device
   Wire.onRequest(OnDataRequestedByMaster); // register event to handle Master's request for slave data.
   Wire.onReceive(OnDataReceivedFromMaster); // Register event to handle Master's startup Sync byte.
+#endif // ENABLE_UART_LINK
 
   DBG_PRINT_LN("LeftHandSetup::Setup() - Setup done.");
 }
 
 int LeftHandSetupManager::GetNumButtons()
 {
-  return COUNT_ENTRIES(leftHandButtons);
+  return leftHandButtons.GetNumButtons();
 }
 
-Button& LeftHandSetupManager::GetButtonAt(int index)
+ButtonArray& LeftHandSetupManager::GetButtons()
 {
-  return leftHandButtons[index];
+  return leftHandButtons;
 }
 
 // --- I2C Callbacks
@@ -107,54 +210,356 @@ void LeftHandSetupManager::OnDataRequestedByMaster()
 { 
   //if(!gIsSendMidi) { DbgPrintLn("LeftHandSetupManager OnDataRequestedByMaster() - Entered."); }
 
-  static bool busy = false;
+#ifdef PRINT_LH_BUTTON_FLAGS
+    DBG_PRINT_LN();
+    DBG_PRINT_LN("LeftHandSetupManager OnDataRequestedByMaster() - Slave received request from Master.");
+ #endif
+
+  //blinkOnce();
 
-  if (busy)
+  if (sCommand == ReadLeftHandStatus)
   {
-    DBG_PRINT_LN("LeftHandSetupManager OnDataRequestedByMaster() - Slave received request from Master but Slave is busy from previous request. currentMessageIndex = " + String(sCurrentMessageIndex));
-    
+    Wire.write(sStatusReplies[sPublishedStatusIndex], NumStatusReplyBytes);
+
+    // Without the delta protocol, the next request is a snapshot, without a command.
+    sCommand = ReadLeftHandSnapshot;
     return;
   }
 
-  busy = true;
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+  if (sCommand == ReadLeftHandEventCount || sCommand == ReadLeftHandEvents)
+  {
+    if (sCommand == ReadLeftHandEventCount)
+    {
+      WriteButtonEventCount();
+    }
+    else
+    {
+      WriteButtonEvents();
+    }
+
+#ifdef ENABLE_LH_DATA_READY_LINE
+    if (gLeftHandButtonEventQueue.IsEmpty() && !gIsLeftHandSnapshotRequired)
+    {
+      ClearDataReady();
+    }
+#endif
 
-#ifdef PRINT_LH_BUTTON_FLAGS
-    DBG_PRINT_LN();
-    DBG_PRINT_LN("LeftHandSetupManager OnDataRequestedByMaster() - Slave received request from Master.");
- #endif
+    return;
+  }
 
-  //blinkOnce();
+  // ReadLeftHandSnapshot; the snapshot holds the queued button events.
+  gLeftHandButtonEventQueue.Clear();
+  gIsLeftHandSnapshotRequired = false;
+  sNumReportedButtonEvents = 0;
+#endif // ENABLE_I2C_DELTA_PROTOCOL
   
-  // Master expects 6 bytes of data; three 16-bit words for Bass, Chord, Tone buttons, 1 byte for Volume Pot value.
-  // Cast 16-bit words as arrays of bytes.
-  uint8_t* BassButtonBytes = (byte*)&gBassButtonFlags;
-  uint8_t* ChordButtonBytes = (byte*)&gChordButtonFlags;
-  uint8_t* ToneButtonBytes = (byte*)&gToneButtonFlags;
+  // Master expects 6 bytes of data; three 16-bit words for Bass, Chord, Tone buttons.
+  // The reply was built by PublishSnapshot(); the flags may be changing in loop() meanwhile, but the published reply is not.
+  Wire.write(sSnapshotReplies[sPublishedSnapshotIndex], NumSnapshotReplyBytes);
+
+#ifdef ENABLE_LH_DATA_READY_LINE
+  // A button change after this point sets the line again.
+  ClearDataReady();
+#endif
+}
+
+// This method builds the snapshot reply from the button flags, and publishes it for OnDataRequestedByMaster().
+// Called by loop() after the button flags change, and before the change is queued, so that a snapshot sent meanwhile already includes it.
+void LeftHandSetupManager::PublishSnapshot()
+{
+  uint8_t* snapshotReply = sSnapshotReplies[sPublishedSnapshotIndex ^ 1];
+  uint8_t numBytes = 0;
+
+#ifdef ENABLE_LH_FRAME_CHECK
+  snapshotReply[numBytes++] = ++sFrameGeneration;
+#endif
+
+  // Low byte first, as the RH Arduino expects.
+  snapshotReply[numBytes++] = lowByte(gBassButtonFlags);
+  snapshotReply[numBytes++] = highByte(gBassButtonFlags);
+  snapshotReply[numBytes++] = lowByte(gChordButtonFlags);
+  snapshotReply[numBytes++] = highByte(gChordButtonFlags);
+  snapshotReply[numBytes++] = lowByte(gToneButtonFlags);
+  snapshotReply[numBytes++] = highByte(gToneButtonFlags);
+
+#ifdef ENABLE_LH_FRAME_CHECK
+  snapshotReply[numBytes] = Crc8(snapshotReply, numBytes);
+#endif
 
 #ifdef PRINT_LH_BUTTON_FLAGS
-  DBG_PRINT("LeftHandSetupManager OnDataRequestedByMaster() - BassButtonFlags: b"); PRINTBIN(gBassButtonFlags);
-  DBG_PRINT("LeftHandSetupManager OnDataRequestedByMaster() ChordButtonFlags: b"); PRINTBIN(gChordButtonFlags);
-  DBG_PRINT("LeftHandSetupManager OnDataRequestedByMaster() ToneButtonFlags: b"); PRINTBIN(gToneButtonFlags);
+  DBG_PRINT("LeftHandSetupManager PublishSnapshot() - BassButtonFlags: b"); PRINTBIN(gBassButtonFlags);
+  DBG_PRINT("LeftHandSetupManager PublishSnapshot() - ChordButtonFlags: b"); PRINTBIN(gChordButtonFlags);
+  DBG_PRINT("LeftHandSetupManager PublishSnapshot() - ToneButtonFlags: b"); PRINTBIN(gToneButtonFlags);
+#endif
 
-  DBG_PRINT_LN(String("LeftHandSetupManager OnDataRequestedByMaster() - Slave Write BassButtonBytes=") + String(BassButtonBytes[0], HEX) + String(BassButtonBytes[1], HEX));
-  DBG_PRINT_LN(String("LeftHandSetupManager OnDataRequestedByMaster() - Slave Write ChordButtonBytes=") + String(ChordButtonBytes[0], HEX) + String(ChordButtonBytes[1], HEX));
-  DBG_PRINT_LN(String("LeftHandSetupManager OnDataRequestedByMaster() - Slave Write ToneButtonBytes=") + String(ToneButtonBytes[0], HEX) + String(ToneButtonBytes[1], HEX));
+  // A one-byte write is atomic; the I2C interrupt copies either the previous reply, or this one, but never a mix of both.
+  sPublishedSnapshotIndex ^= 1;
+
+#if defined(ENABLE_UART_LINK) && !defined(ENABLE_I2C_DELTA_PROTOCOL)
+  // Without the delta protocol, the RH Arduino is sent each snapshot.
+  SendSnapshotFrame();
 #endif
+}
+
+#ifdef ENABLE_UART_LINK
 
-  Wire.write(BassButtonBytes, 2);
-  Wire.write(ChordButtonBytes, 2);
-  Wire.write(ToneButtonBytes, 2);
+// Sends the published snapshot as a UART link frame.
+void LeftHandSetupManager::SendSnapshotFrame()
+{
+  WriteUartLinkFrame(UartLinkSnapshotFrame, sSnapshotReplies[sPublishedSnapshotIndex], NumSnapshotReplyBytes);
+  sLastSnapshotFrameTimeMs = millis();
+}
 
-  sCurrentMessageIndex++;
+// Sends the published snapshot again every LeftHandKeepAlivePollIntervalMs, so that the RH Arduino recovers from a lost frame,
+// or a later connection. Called by loop().
+void LeftHandSetupManager::UpdateUartLink(unsigned long curTimeMs)
+{
+  if (curTimeMs - sLastSnapshotFrameTimeMs >= LeftHandKeepAlivePollIntervalMs)
+  {
+    SendSnapshotFrame();
+  }
+}
 
-  busy = false;
+// Sends a LH button event as a UART link frame. Called by loop() after the event's snapshot is published.
+void LeftHandSetupManager::SendButtonEventFrame(uint8_t buttonEvent)
+{
+  WriteUartLinkFrame(UartLinkButtonEventFrame, &buttonEvent, 1);
 }
 
+#endif // ENABLE_UART_LINK
+
 // function that executes whenever data is received from master
 // this function is registered as an event, see setup()
-void LeftHandSetupManager::OnDataReceivedFromMaster(int eventType)
+// The master writes the command of its next request, or a configuration command, followed by its value; see LeftHandI2CCommand.
+// A configuration command is queued for loop() to handle; one received while the queue is full is dropped.
+void LeftHandSetupManager::OnDataReceivedFromMaster(int numBytes)
 {
-  DBG_PRINT_LN("LeftHandSetupManager OnDataReceivedFromMaster() - Event type = " + String(eventType, HEX)+ ".");
+  if (Wire.available() == 0)
+  {
+    return;
+  }
+
+  uint8_t command = Wire.read();
+  if (command >= SetLeftHandScanInterval && command != ReadLeftHandStatus)
+  {
+    LeftHandCommand pendingCommand;
+    pendingCommand.numBytes = 0;
+    pendingCommand.bytes[pendingCommand.numBytes++] = command;
+    while (Wire.available() && pendingCommand.numBytes < MaxLeftHandCommandBytes)
+    {
+      pendingCommand.bytes[pendingCommand.numBytes++] = Wire.read();
+    }
+
+    sPendingCommands.Push(pendingCommand);
+  }
+  else
+  {
+    sCommand = command;
+  }
+
+  while (Wire.available())
+  {
+    Wire.read();
+  }
+}
+
+// This method handles the configuration commands of the RH Arduino, received since the last call, in order. Called by loop(), between scans.
+void LeftHandSetupManager::HandleMasterCommands()
+{
+  LeftHandCommand pendingCommand;
+  while (sPendingCommands.Pop(pendingCommand))
+  {
+    HandleMasterCommand(pendingCommand.bytes, pendingCommand.numBytes);
+  }
+
+#ifdef ENABLE_UART_LINK
+  while (UART_LINK_SERIAL.available() > 0)
+  {
+    if (sUartLinkFrameParser.Parse(UART_LINK_SERIAL.read()) == UartLinkFrameParser::FrameReceived &&
+        sUartLinkFrameParser.GetFrameType() == UartLinkCommandFrame && sUartLinkFrameParser.GetNumPayloadBytes() > 0)
+    {
+      HandleMasterCommand(sUartLinkFrameParser.GetPayload(), sUartLinkFrameParser.GetNumPayloadBytes());
+    }
+  }
+#endif // ENABLE_UART_LINK
+}
+
+// Applies the command passed in; a command without its value is ignored.
+void LeftHandSetupManager::HandleMasterCommand(const uint8_t* commandBytes, uint8_t numCommandBytes)
+{
+  switch (commandBytes[0])
+  {
+    case SetLeftHandScanInterval:
+      if (numCommandBytes == 3)
+      {
+        sScanIntervalMicroseconds = word(commandBytes[2], commandBytes[1]);
+        DBG_PRINT_LN("LeftHandSetupManager::HandleMasterCommand() - Scan interval = " + String(sScanIntervalMicroseconds) + " Microseconds.");
+      }
+      break;
+
+    case SetLeftHandDebounceDelay:
+      if (numCommandBytes == 2)
+      {
+#ifdef ENABLE_PORT_REGISTER_SCAN
+        leftHandButtonPortScanner.SetDebounceDelayMs(commandBytes[1]);
+#else
+        leftHandButtons.SetDebounceDelayMs(commandBytes[1]);
+#endif
+        DBG_PRINT_LN("LeftHandSetupManager::HandleMasterCommand() - Debounce delay = " + String(commandBytes[1]) + " ms.");
+      }
+      break;
+
+    case RequestLeftHandSnapshot:
+#ifdef ENABLE_UART_LINK
+      SendSnapshotFrame();
+#else
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+      gIsLeftHandSnapshotRequired = true;
+#endif
+#ifdef ENABLE_LH_DATA_READY_LINE
+      SetDataReady();
+#endif
+#endif // ENABLE_UART_LINK
+      break;
+
+#ifdef ENABLE_UART_LINK
+    case ReadLeftHandStatus:
+      WriteUartLinkFrame(UartLinkStatusFrame, sStatusReplies[sPublishedStatusIndex], NumStatusReplyBytes);
+      break;
+#endif
+  }
+
+  // The status reports the configuration.
+  PublishStatus(millis());
+}
+
+// Returns true if the scan interval has elapsed since the last scan started; the scan then starts. Called by loop().
+bool LeftHandSetupManager::BeginScan()
+{
+  unsigned long curTimeMicroseconds = micros();
+  if (curTimeMicroseconds - sScanStartTimeMicroseconds < sScanIntervalMicroseconds)
+  {
+    return false;
+  }
+
+  sScanStartTimeMicroseconds = curTimeMicroseconds;
+  return true;
 }
 
+// Adds the scan to the statistics of the current window; once the window is complete, its statistics are published.
+// Called by loop() at the end of each scan, with the ScanFrame time.
+void LeftHandSetupManager::EndScan(unsigned long curTimeMs)
+{
+  unsigned long scanTimeMicroseconds = micros() - sScanStartTimeMicroseconds;
+  if (scanTimeMicroseconds > 0xFFFF)
+  {
+    scanTimeMicroseconds = 0xFFFF;
+  }
+
+  if (sNumScans < 0xFFFF)
+  {
+    sNumScans++;
+  }
+
+  sTotalScanTimeMicroseconds += scanTimeMicroseconds;
+  if (scanTimeMicroseconds > sMaxScanTimeMicroseconds)
+  {
+    sMaxScanTimeMicroseconds = scanTimeMicroseconds;
+  }
+
+  if (curTimeMs - sScanStatsWindowStartTimeMs < LeftHandScanStatsWindowMs)
+  {
+    return;
+  }
+
+  sLastWindowNumScans = sNumScans;
+  sLastWindowAverageScanTimeMicroseconds = sTotalScanTimeMicroseconds / sNumScans;
+  sLastWindowMaxScanTimeMicroseconds = sMaxScanTimeMicroseconds;
+  PublishStatus(curTimeMs);
+
+  sScanStatsWindowStartTimeMs = curTimeMs;
+  sNumScans = 0;
+  sTotalScanTimeMicroseconds = 0;
+  sMaxScanTimeMicroseconds = 0;
+}
+
+// This method builds the status reply, and publishes it for OnDataRequestedByMaster(), as PublishSnapshot() does the snapshot reply.
+// The uptime is in seconds, from the time passed in; the RH Arduino detects a restart from it.
+void LeftHandSetupManager::PublishStatus(unsigned long curTimeMs)
+{
+  uint16_t uptimeSeconds = curTimeMs / 1000;
+
+  uint8_t* statusReply = sStatusReplies[sPublishedStatusIndex ^ 1];
+  statusReply[LeftHandStatusVersionMajor] = FirmwareVersionMajor;
+  statusReply[LeftHandStatusVersionMinor] = FirmwareVersionMinor;
+  statusReply[LeftHandStatusScanIntervalLow] = lowByte(sScanIntervalMicroseconds);
+  statusReply[LeftHandStatusScanIntervalHigh] = highByte(sScanIntervalMicroseconds);
+  statusReply[LeftHandStatusDebounceDelay] = leftHandButtons.GetDebounceDelayMs();
+  statusReply[LeftHandStatusNumScansLow] = lowByte(sLastWindowNumScans);
+  statusReply[LeftHandStatusNumScansHigh] = highByte(sLastWindowNumScans);
+  statusReply[LeftHandStatusAverageScanTimeLow] = lowByte(sLastWindowAverageScanTimeMicroseconds);
+  statusReply[LeftHandStatusAverageScanTimeHigh] = highByte(sLastWindowAverageScanTimeMicroseconds);
+  statusReply[LeftHandStatusMaxScanTimeLow] = lowByte(sLastWindowMaxScanTimeMicroseconds);
+  statusReply[LeftHandStatusMaxScanTimeHigh] = highByte(sLastWindowMaxScanTimeMicroseconds);
+  statusReply[LeftHandStatusUptimeLow] = lowByte(uptimeSeconds);
+  statusReply[LeftHandStatusUptimeHigh] = highByte(uptimeSeconds);
+
+#ifdef ENABLE_LH_FRAME_CHECK
+  statusReply[NumLeftHandStatusBytes] = Crc8(statusReply, NumLeftHandStatusBytes);
+#endif
+
+  sPublishedStatusIndex ^= 1;
+}
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+
+// Replies with the number of queued button events, up to MaxLeftHandButtonEventsPerFetch, and remembers it for the ReadLeftHandEvents request.
+// If button events were dropped, replies LeftHandSnapshotRequired instead.
+void LeftHandSetupManager::WriteButtonEventCount()
+{
+  if (gIsLeftHandSnapshotRequired)
+  {
+    sNumReportedButtonEvents = 0;
+    Wire.write(LeftHandSnapshotRequired);
+    return;
+  }
+
+  uint8_t numButtonEvents = gLeftHandButtonEventQueue.GetCount();
+  if (numButtonEvents > MaxLeftHandButtonEventsPerFetch)
+  {
+    numButtonEvents = MaxLeftHandButtonEventsPerFetch;
+  }
+
+  sNumReportedButtonEvents = numButtonEvents;
+  Wire.write(numButtonEvents);
+}
+
+// Replies with the button events reported by the last ReadLeftHandEventCount reply, oldest first.
+// With ENABLE_LH_FRAME_CHECK, the events are followed by their CRC-8.
+void LeftHandSetupManager::WriteButtonEvents()
+{
+  uint8_t buttonEvent;
+#ifdef ENABLE_LH_FRAME_CHECK
+  uint8_t crc = 0;
+#endif
+  for (uint8_t i = 0; i < sNumReportedButtonEvents && gLeftHandButtonEventQueue.Pop(buttonEvent); i++)
+  {
+    Wire.write(buttonEvent);
+#ifdef ENABLE_LH_FRAME_CHECK
+    crc = Crc8(&buttonEvent, 1, crc);
+#endif
+  }
+
+#ifdef ENABLE_LH_FRAME_CHECK
+  Wire.write(crc);
+#endif
+
+  sNumReportedButtonEvents = 0;
+}
+
+#endif // ENABLE_I2C_DELTA_PROTOCOL
+
+#endif // BUILD_LEFT_HAND_SLAVE
+
 
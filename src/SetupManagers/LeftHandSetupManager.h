@@ -27,8 +27,16 @@
 #ifndef LeftHandSetupManager_H
 #define LeftHandSetupManager_H
 
+#include "../MIDIAccordion.h"
+
 #include "SetupManagerBase.h"
 #include "../SharedConstants.h"
+#include "../EventQueue.h"
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+// LH button events not yet sent to the RH Arduino. Added by LeftHandButtonChangedHandler, and sent from the I2C interrupt.
+typedef EventQueue<uint8_t, LeftHandButtonEventQueueSize> LeftHandButtonEventQueue;
+#endif
 
 class LeftHandSetupManager : public SetupManagerBase
 {
@@ -37,11 +45,40 @@ public:
 
   void Setup();
   int GetNumButtons();
-  Button& GetButtonAt(int index);
+  ButtonArray& GetButtons();
   
   // Callback methods; must be static to be used as C++ function pointers.
   static void OnDataRequestedByMaster();
-  static void OnDataReceivedFromMaster(int eventType);
+  static void OnDataReceivedFromMaster(int numBytes);
+
+  // Publishes the button flags as the snapshot reply. Called by loop() only.
+  static void PublishSnapshot();
+
+  // These methods are called by loop(); the commands of the RH Arduino are handled between scans, which are paced by the scan interval.
+  static void HandleMasterCommands();
+  static bool BeginScan();
+  static void EndScan(unsigned long curTimeMs);
+
+#ifdef ENABLE_UART_LINK
+  static void SendSnapshotFrame();
+  static void SendButtonEventFrame(uint8_t buttonEvent);
+  static void UpdateUartLink(unsigned long curTimeMs);
+#endif
+
+#ifdef ENABLE_LH_DATA_READY_LINE
+  // Signals the RH Arduino that button states changed. Called after the button flags, and events, are updated.
+  static void SetDataReady() { digitalWrite(LeftHandDataReadyPin, LOW); }
+  static void ClearDataReady() { digitalWrite(LeftHandDataReadyPin, HIGH); }
+#endif
+
+protected:
+  static void HandleMasterCommand(const uint8_t* commandBytes, uint8_t numCommandBytes);
+  static void PublishStatus(unsigned long curTimeMs);
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+  static void WriteButtonEventCount();
+  static void WriteButtonEvents();
+#endif
 };
 
 #endif
@@ -24,14 +24,28 @@
   
  ******************************************************************************/
 
-#include <Wire.h>
+#include "../lib/ArduMidi/ardumidi.h"
 
 #include "RightHandSetupManager.h"
 #include "../Utilities/Utilities.h"
 #include "../SharedMacros.h"
 
+#ifdef BUILD_RIGHT_HAND_MASTER
+#include "../LeftHandLink.h"
+#endif
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_MIDI_TRANSMIT_QUEUE)
+#include "../MidiTransmitQueue.h"
+#endif
+
 // Global Variables
-extern Button rightHandButtons[NumRightHandButtons];
+extern ButtonArrayOf<NumRightHandButtons> rightHandButtons;
+
+#ifdef BUILD_RIGHT_HAND_MASTER
+extern LeftHandLink gLeftHandLink;
+#endif
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_MIDI_TRANSMIT_QUEUE)
+extern MidiTransmitQueue gMidiTransmitQueue;
+#endif
 
 RightHandSetupManager::RightHandSetupManager() : SetupManagerBase()
 {
@@ -46,6 +60,12 @@ void RightHandSetupManager::Setup()
 
 #ifdef SEND_MIDI
   Serial.begin(BaudRateMidi);
+#ifdef ENABLE_MIDI_RUNNING_STATUS
+  midi_set_running_status(true, MidiRunningStatusRefreshMs);
+#endif
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_MIDI_TRANSMIT_QUEUE)
+  gMidiTransmitQueue.Begin();
+#endif
 #else
   // Write to Serial Monitor.
   Serial.begin(BaudRateSerialMonitor);
@@ -54,15 +74,21 @@ void RightHandSetupManager::Setup()
   int numButtons = GetNumButtons();
   for (char i = 0; i < numButtons; i++)
   {
-    pinMode(GetButtonAt(i).buttonState.pin, INPUT_PULLUP);
+    // The button pins come from the pin map in ButtonLayout.h.
+    pinMode(GetButtons().GetPin(i), INPUT_PULLUP);
   }
 
 #ifndef DISABLE_I2C
   // if(!gIsSendMidi) { DbgPrintLn("RightHandSetup::Setup() - Starting I2C."); }
 
-  // Setup Master I2C
-  // Initiate the Wire library and join the I2C bus as a master.
-  Wire.begin();
+  // Setup the link to the LH Arduino, as the master.
+#ifdef BUILD_RIGHT_HAND_MASTER
+  gLeftHandLink.Begin();
+#endif
+
+#ifdef ENABLE_LH_DATA_READY_LINE
+  pinMode(LeftHandDataReadyPin, INPUT_PULLUP);
+#endif
 #endif // DISABLE_I2C
 
   // Indicated that RH Arduino is ready.
@@ -73,10 +99,10 @@ void RightHandSetupManager::Setup()
 
 int RightHandSetupManager::GetNumButtons()
 {
-  return COUNT_ENTRIES(rightHandButtons);
+  return rightHandButtons.GetNumButtons();
 }
 
-Button& RightHandSetupManager::GetButtonAt(int index)
+ButtonArray& RightHandSetupManager::GetButtons()
 {
-  return rightHandButtons[index];
+  return rightHandButtons;
 }
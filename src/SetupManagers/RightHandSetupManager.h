@@ -37,7 +37,7 @@ public:
 
   void Setup();
   int GetNumButtons();
-  Button& GetButtonAt(int index);
+  ButtonArray& GetButtons();
 };
 
 #endif
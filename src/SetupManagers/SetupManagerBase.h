@@ -36,7 +36,7 @@ public:
   
   virtual void Setup() = 0;
   virtual int GetNumButtons() = 0;
-  virtual Button& GetButtonAt(int index) = 0;
+  virtual ButtonArray& GetButtons() = 0;
 };
 
 #endif
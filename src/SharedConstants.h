@@ -36,15 +36,81 @@ const uint32_t MidiEventFlashDurationMilliseconds = 10;
 // MIDI Baud rate is 31250 bits per second.
 const unsigned long BaudRateMidi = 31250;
 
+// With ENABLE_MIDI_RUNNING_STATUS, the longest time a status byte is omitted; so a receiver connected mid-stream picks up the running status.
+// A 3-byte message takes 960 us at 31250 baud; each omitted status byte saves 320 us.
+const unsigned long MidiRunningStatusRefreshMs = 250;
+
+// The MIDI transmit queue, used if ENABLE_MIDI_TRANSMIT_QUEUE is defined; the number of notes, program changes, and discrete control
+// changes, it may queue, plus one. Must be a power of 2. If it is full, its oldest message is written, waiting for the Serial TX buffer.
+const uint8_t MidiTransmitQueueSize = 32;
+
+// The most continuous control changes pending at once; one per MIDI channel and control. A volume change adds one per layer.
+// If the table is full, a control change is queued with the notes, and not coalesced.
+const uint8_t MaxPendingControlChanges = 24;
+
+// Control changes are written only while at least this many bytes of the Serial TX buffer, 64 bytes by default, are free;
+// so the notes queued meanwhile do not wait behind them.
+const uint8_t MidiControlChangeMinFreeTxBytes = 32;
+
+// The longest MIDI channel message; a status byte, and 2 data bytes.
+const uint8_t MaxMidiMessageBytes = 3;
+
+// The MIDI out bandwidth; each byte is 10 bits on the wire, a start bit, 8 data bits, and a stop bit.
+const unsigned long MidiBytesPerSecond = BaudRateMidi / 10;
+
+// The MIDI bandwidth meter measures the bytes sent per window of this length; about 31 bytes fit in 10 ms.
+const unsigned long MidiBandwidthWindowMs = 10;
+
+// The MIDI out is busy if the last window used at least this percentage of the bandwidth, or the Serial TX buffer is half full;
+// producers of continuous controllers then back off; see MidiBandwidthMeter.
+const uint8_t MidiBandwidthBusyPercent = 75;
+
 // 9600 is the default rate. This rate is used to show that after uploading a new program, a previous session's debug message is still in the serial buffer.
 const unsigned long BaudRateSerialMonitor = 9600;
 // const unsigned long BaudRateSerialMonitor = 115200;
 
 const byte LeftHandI2CDeviceId = 1;
 
+// Pin wired between both Arduinos, used if ENABLE_LH_DATA_READY_LINE is defined; A8 (pin 62) is spare on both, and is not used by
+// any serial port, I2C, PWM, or the RH sensors (A0 to A4). Pins 14 to 19 are the Serial1 to Serial3 pins, and 20, and 21, the I2C pins.
+// The LH Arduino drives it LOW while it has button changes the RH Arduino has not read. The RH Arduino pulls it up, so it reads idle if not connected.
+const uint8_t LeftHandDataReadyPin = A8;
+
+// The RH Arduino requests the LH button states at least this often, even if the data ready line is idle.
+const unsigned long LeftHandKeepAlivePollIntervalMs = 100;
+
 const int NumRightHandButtons = 43; // 41 Keys + 2 Custom Buttons.
 const int NumLeftHandButtons = 38;
 
+// Right Hand Button index ranges.
+const uint8_t FirstRightHandKeyIndex = 0;
+const uint8_t NumRightHandKeys = 41;
+const uint8_t FirstRightHandCustomButtonIndex = 41;
+const uint8_t NumRightHandCustomButtons = 2;
+
+// Left Hand Button index ranges.
+const uint8_t FirstBassButtonIndex = 0;
+const uint8_t NumBassButtons = 12;
+const uint8_t FirstChordButtonIndex = 12;
+const uint8_t NumChordButtons = 12;
+const uint8_t FirstToneSwitchIndex = 24;
+const uint8_t NumToneSwitches = 14;
+
+// The banks of buttons. A bank is a contiguous range of button indexes that is handled by one handler.
+enum ButtonBank
+{
+  RightHandKeys,
+  RightHandCustomButtons,
+  LeftHandBassButtons,
+  LeftHandChordButtons,
+  LeftHandToneSwitches,
+  NumButtonBanks
+};
+
+// The LH banks are the last banks; the LH Arduino sends the button flags of each, in bank order.
+const uint8_t FirstLeftHandButtonBank = LeftHandBassButtons;
+const uint8_t NumLeftHandButtonBanks = NumButtonBanks - FirstLeftHandButtonBank;
+
 const int NumLeftHandSensors = 0;
 const int NumRightHandSensors = 5; // Bellows Slide Pot, and 4 Rotary Potentiometers.
 
@@ -52,11 +118,222 @@ const int NumRightHandSensors = 5; // Bellows Slide Pot, and 4 Rotary Potentiome
 // It is an unsigned longs because the time, measured in milliseconds, will quickly become a bigger number than can be stored in an int.
 const unsigned long DebounceDelayMs = 20;
 
+// The strategy used to debounce buttons on the RH Arduino.
+enum DebounceStrategy
+{
+  // A button may toggle only after DebounceDelayMs has elapsed since its last toggle; one timestamp per button.
+  TimeWindowDebounce,
+
+  // Bit-parallel vertical counters; a button toggles after it reads the new state for VerticalCounterNumSamples consecutive samples.
+  VerticalCounterDebounce
+};
+
+// VerticalCounterDebounce applies to the RH button banks read by port register scan (ENABLE_PORT_REGISTER_SCAN), and to the LH button flags.
+const DebounceStrategy ButtonDebounceStrategy = TimeWindowDebounce;
+
+// The debounce policy of a bank of buttons.
+enum DebouncePolicy
+{
+  // Presses and releases are both filtered by the debounce strategy.
+  SymmetricDebounce,
+
+  // A press is accepted on its first edge, with no wait, to minimize note-on latency.
+  // Only releases, and re-presses while a release is settling, are filtered.
+  EagerPressDebounce
+};
+
+// Debounce policy of each ButtonBank. Tone switches, and custom buttons, do not need the low-latency path.
+const DebouncePolicy BankDebouncePolicies[NumButtonBanks] = {
+  EagerPressDebounce, // RightHandKeys
+  SymmetricDebounce,  // RightHandCustomButtons
+  EagerPressDebounce, // LeftHandBassButtons
+  EagerPressDebounce, // LeftHandChordButtons
+  SymmetricDebounce   // LeftHandToneSwitches
+  };
+
+// Vertical counter samples span the debounce time.
+const unsigned long VerticalCounterNumSamples = 4;
+const unsigned long VerticalCounterSamplePeriodMs = DebounceDelayMs / VerticalCounterNumSamples;
+
+// The rate at which the RH keys are sampled by the timer interrupt, when ENABLE_TIMER_KEY_SCAN is defined.
+const unsigned long KeyScanRateHz = 2000;
+
+// The number of button events the timer interrupt may queue before loop() drains them. Must be a power of 2.
+const uint8_t ButtonEventQueueSize = 32;
+
+// The number of Port B snapshots the pin change interrupt may queue between scans, when ENABLE_PIN_CHANGE_CAPTURE is defined. Must be a power of 2.
+const uint8_t PinChangeSnapshotQueueSize = 16;
+
+// The number of button events a ScanFrame holds before they are dispatched early, to make room; see ScanFrame.h.
+const uint8_t MaxScanFrameButtonEvents = 16;
+
 // Number of data bytes (button bit mask bytes) expected from LH Arduino.
 // 2 Bytes for Bass Button bit mask.
 // 2 Bytes for Chord Button bit mask.
 // 2 Bytes for Tone Button bit mask.
 const int NumBytesExpectedFromLeftHandArduino = 6;
+static_assert(NumBytesExpectedFromLeftHandArduino == 2 * NumLeftHandButtonBanks, "The LH Arduino sends 2 bytes per LH bank.");
+
+// I2C delta protocol, used if ENABLE_I2C_DELTA_PROTOCOL is defined. The RH Arduino writes one of these command bytes before each request.
+// ReadLeftHandEventCount: LH Arduino replies with the number of queued button events, or LeftHandSnapshotRequired.
+// ReadLeftHandEvents: LH Arduino replies with the number of button events of the last ReadLeftHandEventCount reply, oldest first.
+// ReadLeftHandSnapshot: LH Arduino clears its queued button events, and replies with the button flags, as without the delta protocol.
+// The configuration commands are used with, or without, the delta protocol; the RH Arduino sends them between fetches.
+// SetLeftHandScanInterval: followed by the scan interval in microseconds, low byte first; 0 scans as often as loop() runs. No reply.
+// SetLeftHandDebounceDelay: followed by the debounce delay in ms; used only if ENABLE_LH_SLAVE_DEBOUNCE is defined. No reply.
+// RequestLeftHandSnapshot: LH Arduino publishes its button flags again, and, with the delta protocol, replies LeftHandSnapshotRequired
+//   to the next ReadLeftHandEventCount; the RH Arduino sends it to resync after link errors. No reply.
+// ReadLeftHandStatus: LH Arduino replies with its status; see LeftHandStatusByte.
+enum LeftHandI2CCommand
+{
+  ReadLeftHandEventCount = 1,
+  ReadLeftHandEvents = 2,
+  ReadLeftHandSnapshot = 3,
+  SetLeftHandScanInterval = 4,
+  SetLeftHandDebounceDelay = 5,
+  RequestLeftHandSnapshot = 6,
+  ReadLeftHandStatus = 7
+};
+
+// The most bytes of a command; the command byte, and its value.
+const uint8_t MaxLeftHandCommandBytes = 3;
+
+// The configuration commands the LH Arduino may receive before its loop() handles them, plus one. Must be a power of 2.
+// The RH Arduino sends at most one of each command at a time; see ButtonsManager::StartLeftHandCommand().
+const uint8_t LeftHandCommandQueueSize = 8;
+
+// The firmware version, reported by the LH Arduino in its status; the RH Arduino may check that both halves match.
+const uint8_t FirmwareVersionMajor = 1;
+const uint8_t FirmwareVersionMinor = 0;
+
+// The configuration the RH Arduino sends to the LH Arduino at startup, and after a resync; so tuning it only needs the RH Arduino reflashed.
+const uint16_t LeftHandScanIntervalMicroseconds = 0;
+const uint8_t LeftHandDebounceDelayMs = DebounceDelayMs;
+
+// The configuration the RH Arduino sends to the LH Arduino while ToneButtonRole::LeftHandSlowScanEnabled is On.
+const uint16_t LeftHandSlowScanIntervalMicroseconds = 1000;
+const uint8_t LeftHandSlowDebounceDelayMs = 2 * DebounceDelayMs;
+
+// The LH Arduino scan statistics are of the last complete window of this length.
+const unsigned long LeftHandScanStatsWindowMs = 1000;
+
+// The RH Arduino reads the LH Arduino status this often. If the LH uptime it reports fell behind by more than LeftHandUptimeToleranceSeconds,
+// the LH Arduino restarted, and the RH Arduino resyncs it; the reported uptime is that of the last scan statistics window, so it lags by up to 1 s.
+const unsigned long LeftHandStatusPollIntervalMs = 1000;
+const uint16_t LeftHandUptimeToleranceSeconds = 2;
+
+// The bytes of the ReadLeftHandStatus reply; 16-bit values are low byte first. With ENABLE_LH_FRAME_CHECK, they are followed by their CRC-8.
+enum LeftHandStatusByte
+{
+  LeftHandStatusVersionMajor,
+  LeftHandStatusVersionMinor,
+  LeftHandStatusScanIntervalLow,
+  LeftHandStatusScanIntervalHigh,
+  LeftHandStatusDebounceDelay,
+  LeftHandStatusNumScansLow,
+  LeftHandStatusNumScansHigh,
+  LeftHandStatusAverageScanTimeLow,
+  LeftHandStatusAverageScanTimeHigh,
+  LeftHandStatusMaxScanTimeLow,
+  LeftHandStatusMaxScanTimeHigh,
+  LeftHandStatusUptimeLow,
+  LeftHandStatusUptimeHigh,
+  NumLeftHandStatusBytes
+};
+
+// Reply to ReadLeftHandEventCount if the LH Arduino dropped button events; the RH Arduino then reads a snapshot.
+const uint8_t LeftHandSnapshotRequired = 0xFF;
+
+// A LH button event is one byte; the LH button index, and the active state in the high bit.
+const uint8_t LeftHandButtonEventActiveFlag = 0x80;
+const uint8_t LeftHandButtonEventIndexMask = 0x7F;
+static_assert(NumLeftHandButtons <= LeftHandButtonEventIndexMask + 1, "LH button index does not fit in a LH button event.");
+
+// The number of LH button events the LH Arduino may queue between requests. Must be a power of 2.
+const uint8_t LeftHandButtonEventQueueSize = 32;
+
+// The most LH button events sent in one reply; the Wire library buffers at most 32 bytes.
+const uint8_t MaxLeftHandButtonEventsPerFetch = 16;
+
+// LH frame check, used if ENABLE_LH_FRAME_CHECK is defined. A snapshot is preceded by a generation byte, which the LH Arduino
+// increments each time a button flag changes, and is followed by a CRC-8 of the generation and button flag bytes.
+// A ReadLeftHandEvents reply is followed by a CRC-8 of the button events, and a ReadLeftHandStatus reply by a CRC-8 of the status.
+const uint8_t LeftHandSnapshotCheckNumBytes = 2;
+const uint8_t LeftHandEventsCheckNumBytes = 1;
+const uint8_t LeftHandStatusCheckNumBytes = 1;
+
+// The CRC-8 polynomial, x^8 + x^2 + x + 1; the same as the SMBus packet error code.
+const uint8_t Crc8Polynomial = 0x07;
+
+// The longest reply of the LH Arduino; a snapshot, or the most button events, including the frame check bytes.
+const uint8_t MaxLeftHandReplyBytes = MaxLeftHandButtonEventsPerFetch + LeftHandEventsCheckNumBytes > NumBytesExpectedFromLeftHandArduino + LeftHandSnapshotCheckNumBytes ?
+                                      MaxLeftHandButtonEventsPerFetch + LeftHandEventsCheckNumBytes : NumBytesExpectedFromLeftHandArduino + LeftHandSnapshotCheckNumBytes;
+static_assert(NumLeftHandStatusBytes + LeftHandStatusCheckNumBytes <= MaxLeftHandReplyBytes, "The LH status reply is longer than MaxLeftHandReplyBytes.");
+
+// The I2C clock rate of the RH Arduino; one of:
+// 100000 - Standard mode, the Wire library default.
+// 400000 - Fast mode; shortens each fetch about 4 times. Check the short read count of the I2C telemetry after changing it.
+// 800000 - Beyond the I2C specification; the ATmega2560 can clock it, but only short cables with strong pull-ups are reliable.
+const unsigned long I2CClockHz = 100000;
+static_assert(I2CClockHz == 100000 || I2CClockHz == 400000 || I2CClockHz == 800000, "I2CClockHz must be 100000, 400000, or 800000.");
+
+// The I2C telemetry histogram of fetch times; I2CTelemetryNumBuckets buckets of I2CTelemetryBucketMicroseconds each.
+// The last bucket also counts longer fetches.
+const uint8_t I2CTelemetryNumBuckets = 64;
+const unsigned int I2CTelemetryBucketMicroseconds = 50;
+
+// The telemetry SysEx messages; MIDI manufacturer ID 0x7D is reserved for non-commercial use.
+const uint8_t NonCommercialSysExId = 0x7D;
+
+// The telemetry reports waiting to be sent, plus one; see SysExReportQueue. Must be a power of 2.
+const uint8_t SysExReportQueueSize = 8;
+
+// The most values of a telemetry report. SysEx data bytes are 7 bits; each value is sent as 2 bytes, and saturates at MaxSysExReportValue.
+const uint8_t MaxSysExReportValues = 8;
+const uint16_t MaxSysExReportValue = 0x3FFF;
+
+const uint8_t I2CTelemetrySysExType = 0x01;
+const uint8_t LeftHandStatusSysExType = 0x02;
+const uint8_t MidiByteCountsSysExType = 0x03;
+const uint8_t MidiTransmitQueueSysExType = 0x04;
+const uint8_t MidiBandwidthSysExType = 0x05;
+
+// UART link, used if ENABLE_UART_LINK is defined. A frame is UartLinkFrameSync, the frame type, the payload length, the payload,
+// and the CRC-8 of the type, length, and payload. At 1 Mbaud, a 5-byte button event frame takes 50 us, without any request;
+// an I2C snapshot request takes about 650 us at 100 kHz, and 162 us at 400 kHz, after the RH Arduino polls; as calculated by test_link_wire_time_calculation.
+// Within a frame, a UartLinkFrameSync, or UartLinkFrameEscape, byte is sent as UartLinkFrameEscape, then the byte XOR UartLinkFrameEscapeMask;
+// so UartLinkFrameSync only ever starts a frame, and the receiver resyncs on it after a lost, or corrupted, byte.
+const unsigned long LeftHandLinkBaudRate = 1000000;
+const uint8_t UartLinkFrameSync = 0xA5;
+const uint8_t UartLinkFrameEscape = 0xDB;
+const uint8_t UartLinkFrameEscapeMask = 0x20;
+const uint8_t MaxUartLinkPayloadBytes = MaxLeftHandReplyBytes;
+
+enum UartLinkFrameType
+{
+  // The payload is a snapshot reply; see LeftHandSetupManager::PublishSnapshot(). Sent on each change without the delta protocol,
+  // and every LeftHandKeepAlivePollIntervalMs.
+  UartLinkSnapshotFrame = 1,
+
+  // The payload is one LH button event. Sent on each change with the delta protocol.
+  UartLinkButtonEventFrame = 2,
+
+  // The payload is a command, and its value; see LeftHandI2CCommand. Sent by the RH Arduino.
+  UartLinkCommandFrame = 3,
+
+  // The payload is a ReadLeftHandStatus reply. Sent in reply to the ReadLeftHandStatus command.
+  UartLinkStatusFrame = 4
+};
+
+// The RH Arduino gives up waiting for a UartLinkStatusFrame after this time; the status request then has no reply.
+const unsigned long UartLinkStatusTimeoutMs = 20;
+
+// TwiMaster limits, used if ENABLE_ASYNC_I2C is defined. A request writes at most a command, and reads at most a snapshot, or the most button events.
+const uint8_t MaxTwiWriteBytes = MaxLeftHandCommandBytes;
+const uint8_t MaxTwiReadBytes = MaxLeftHandReplyBytes;
+
+// A TwiMaster transfer that takes longer is aborted, and the bus is recovered. A 17-byte transfer takes about 1.6 ms at 100 kHz.
+const unsigned long TwiTimeoutMicroseconds = 5000;
 
 const byte MaxMidiNotes = 128;
 const byte NumMidiChannels = 16;
@@ -40,8 +40,14 @@
 #ifdef SEND_MIDI
   extern void LogLoopTime();
   #define LOG_LOOP_TIME()
+  #define LOG_SCAN_TIME(scanStartTimeMicroseconds)
+  #define LOG_BUTTON_EVENT_LATENCY(buttonEvent)
+  #define LOG_FRAME_TIME(scanFrame)
 #else
   #define LOG_LOOP_TIME() diagnostics.LogLoopTime()
+  #define LOG_SCAN_TIME(scanStartTimeMicroseconds) diagnostics.LogScanTime(scanStartTimeMicroseconds)
+  #define LOG_BUTTON_EVENT_LATENCY(buttonEvent) diagnostics.LogButtonEventLatency(buttonEvent)
+  #define LOG_FRAME_TIME(scanFrame) diagnostics.LogFrameTime(scanFrame)
 #endif // SEND_MIDI
 
 // Macros
@@ -0,0 +1,100 @@
+/*******************************************************************************
+  TimerKeyScanner.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+
+#include "MIDIAccordion.h"
+
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_TIMER_KEY_SCAN)
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+
+#include "TimerKeyScanner.h"
+
+// Timer1 counts at F_CPU / 8; at 16 MHz, KeyScanRateHz may be from 31 Hz to 2 MHz.
+const unsigned long Timer1Prescaler = 8;
+const unsigned long Timer1CompareValue = F_CPU / Timer1Prescaler / KeyScanRateHz - 1;
+static_assert(Timer1CompareValue > 0 && Timer1CompareValue <= 0xFFFF, "KeyScanRateHz is out of range of Timer1.");
+
+extern TimerKeyScanner gTimerKeyScanner;
+
+ISR(TIMER1_COMPA_vect)
+{
+  gTimerKeyScanner.Scan();
+}
+
+TimerKeyScanner::TimerKeyScanner(ButtonPortScanner& buttonPortScanner) :
+  mButtonPortScanner(buttonPortScanner)
+{
+}
+
+void TimerKeyScanner::Start()
+{
+  noInterrupts();
+
+  // CTC mode (WGM12), clock / 8 (CS11); the counter resets on compare match with OCR1A.
+  TCCR1A = 0;
+  TCCR1B = _BV(WGM12) | _BV(CS11);
+  TCNT1 = 0;
+  OCR1A = Timer1CompareValue;
+  TIMSK1 |= _BV(OCIE1A);
+
+  interrupts();
+}
+
+// This method samples and debounces the bank, then queues an event for each button whose debounced state differs from its queued state.
+// If the queue is full, the remaining buttons stay unqueued, and are queued by a later scan, once loop() has drained the queue;
+// a button that toggled back meanwhile is then not queued at all, so loop() never sees a state the button is no longer in.
+void TimerKeyScanner::Scan()
+{
+  uint64_t pressedButtons = mButtonPortScanner.ReadPressedButtons();
+  unsigned long curTimeMicroseconds = micros();
+  mButtonPortScanner.DebounceButtons(pressedButtons, millis());
+
+  uint64_t activeButtons = mButtonPortScanner.GetDebouncedButtons();
+  uint64_t unqueuedButtons = activeButtons ^ mQueuedButtons;
+
+  ButtonEvent buttonEvent;
+  buttonEvent.timeMicroseconds = curTimeMicroseconds;
+  buttonEvent.bank = mButtonPortScanner.GetBank();
+  while (unqueuedButtons != 0)
+  {
+    uint8_t i = __builtin_ctzll(unqueuedButtons);
+    uint64_t buttonMask = (uint64_t)1 << i;
+
+    buttonEvent.buttonIndex = i;
+    buttonEvent.isActive = (activeButtons & buttonMask) != 0;
+    if (!mButtonEventQueue.Push(buttonEvent))
+    {
+      return;
+    }
+
+    mQueuedButtons ^= buttonMask;
+    unqueuedButtons &= ~buttonMask;
+  }
+}
+
+#endif // BUILD_RIGHT_HAND_MASTER && ENABLE_TIMER_KEY_SCAN
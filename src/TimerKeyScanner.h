@@ -0,0 +1,79 @@
+/*******************************************************************************
+  TimerKeyScanner.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+
+#ifndef TimerKeyScanner_H
+#define TimerKeyScanner_H
+
+#include <Arduino.h>
+
+#include "MIDIAccordion.h"
+
+#ifndef ENABLE_PORT_REGISTER_SCAN
+  #error "ENABLE_TIMER_KEY_SCAN requires ENABLE_PORT_REGISTER_SCAN."
+#endif
+
+#include "ButtonPortScanner.h"
+#include "ButtonEvent.h"
+#include "EventQueue.h"
+#include "SharedConstants.h"
+
+// This class samples a bank of buttons from the Timer1 compare match interrupt, at KeyScanRateHz,
+// so that the sampling rate does not depend on how long the rest of loop() takes (sensor reads, I2C fetches, etc.).
+// Each sample is debounced with the bank's vertical counters, whose evenly spaced samples suit a fixed-rate scan,
+// and the debounced state changes are pushed into an EventQueue, which loop() drains with ButtonsManager::DispatchButtonEvents().
+// The interrupt owns the ButtonPortScanner passed in; it must not be read by ButtonsManager::ReadButtons() as well.
+// The ButtonArray of the scanner is only written by loop(), when the events are dispatched.
+class TimerKeyScanner
+{
+public:
+  TimerKeyScanner(ButtonPortScanner& buttonPortScanner);
+
+  // Starts Timer1 in CTC mode, interrupting at KeyScanRateHz.
+  void Start();
+
+  // Called by the timer interrupt only.
+  void Scan();
+
+  // Called by loop() only. Returns false if there are no pending button events.
+  bool PopButtonEvent(ButtonEvent& buttonEvent) { return mButtonEventQueue.Pop(buttonEvent); }
+
+  ButtonArray& GetButtons() { return mButtonPortScanner.GetButtons(); }
+
+protected:
+  // The default constructor is protected to prevent its usage.
+  TimerKeyScanner();
+
+private:
+  ButtonPortScanner& mButtonPortScanner;
+
+  // The button states that have been pushed into the queue; bit n corresponds to button index n.
+  uint64_t mQueuedButtons = 0;
+
+  EventQueue<ButtonEvent, ButtonEventQueueSize> mButtonEventQueue;
+};
+
+#endif
@@ -30,21 +30,28 @@
 
 #ifdef BUILD_RIGHT_HAND_MASTER
 #include "Button.h"
+#include "ButtonsManager.h"
 #include "MIDIEventFlasher.h"
 #include "SharedMacros.h"
 #include "SharedConstants.h"
 #include "StatusManager.h"
 #include "ToneButtonManager.h"
+#include "Utilities/I2CTelemetry.h"
+#include "Utilities/MidiTelemetry.h"
 #include "Utilities/Utilities.h"
 #include "VolumeChangeManager.h"
 
 extern StatusManager gStatusManager;
 extern VolumeChangeManager gVolumeChangeManager;
+extern I2CTelemetry gI2CTelemetry;
+extern MidiTelemetry gMidiTelemetry;
+extern ButtonsManager* pButtonsManager;
 
 // This class is used by the Right Hand Arduino to keep track of the Tone Button states.
 // If the state changes, this class reacts to the change depending on which switch was toggled.
 // If toggle from Active to Inactive:
 // - ToneButtoneRole::Panic: When toggled to On, sends All Notes of on all MIDI Channels.
+// - ToneButtonRole::SendTelemetry: When toggled to On, sends the I2C telemetry, and the MIDI out statistics, and then the LH Arduino status, once read.
 // - ToneButtonRole::MelodyLayer1Enabled: Sends All Notes Off on MIDI Channel corresponding to RH Layer 1.
 // - ToneButtonRole::MelodyLayer2Enabled: Sends All Notes Off on MIDI Channel corresponding to RH Layer 2.
 // - ToneButtonRole::MelodyLayer3Enabled: Sends All Notes Off on MIDI Channel corresponding to RH Layer 3.
@@ -52,6 +59,7 @@ extern VolumeChangeManager gVolumeChangeManager;
 // If toggle to either state:
 // - ToneButtonRole::BellowsControlledVolumeEnabled: Update MIDI Volume.
 // - ToneButtonRole::StatusLedWhileAnyNoteOn: Set StatusManager mode.
+// - ToneButtonRole::LeftHandSlowScanEnabled: Sets the LH Arduino scan interval, and debounce delay.
 ToneButtonManager::ToneButtonManager()
 {
 }
@@ -81,6 +89,12 @@ void ToneButtonManager::SetIsActive(byte buttonIndex, bool isActive)
           SendAllNotesOffOnChannel(channel);
         }
         break;
+
+      case ToneButtonRole::SendTelemetry:
+        gI2CTelemetry.Report();
+        gMidiTelemetry.Report();
+        pButtonsManager->RequestLeftHandStatus();
+        break;
     }
   }
 
@@ -127,6 +141,11 @@ void ToneButtonManager::SetIsActive(byte buttonIndex, bool isActive)
         gStatusManager.SetStatusIndicatorMode(StatusIndicatorMode::FlashMidiEvents);
       }
       break;
+
+    case ToneButtonRole::LeftHandSlowScanEnabled:
+      pButtonsManager->SetLeftHandScanIntervalMicroseconds(isActive ? LeftHandSlowScanIntervalMicroseconds : LeftHandScanIntervalMicroseconds);
+      pButtonsManager->SetLeftHandDebounceDelayMs(isActive ? LeftHandSlowDebounceDelayMs : LeftHandDebounceDelayMs);
+      break;
   }
 }
 
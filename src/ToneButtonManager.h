@@ -62,11 +62,12 @@ enum ToneButtonRole
   // 08 (On/Off)  - TBD [Middle 3 On/Off]
   TBD08Enabled = 8,
   
-  // 09 (On/Off)  - TBD [High 1 On/Off]
-  TBD09Enabled = 9,
+  // 09 (On/Off)  - When On, the LH Arduino scans every LeftHandSlowScanIntervalMicroseconds, and debounces for LeftHandSlowDebounceDelayMs,
+  // e.g. for bouncy LH contacts; when Off, it uses LeftHandScanIntervalMicroseconds, and LeftHandDebounceDelayMs. [High 1 On/Off]
+  LeftHandSlowScanEnabled = 9,
 
-  // 10 (On/Off)  - TBD [High 2 On/Off]
-  TBD10Enabled = 10,
+  // 10 (Toggle) - Sends the telemetry, the LH fetch time statistics, the LH Arduino status, and the MIDI out statistics, as SysEx messages when state is toggled to On. [High 2 On/Off]
+  SendTelemetry = 10,
 
   // 11 (On/Off)  - When On, Status LED is on while any note is being played; when Off, Status LED briefly flashes for any MIDI Event. [Bass Sustain Short/Long]
   StatusLedWhileAnyNoteOn = 11,
@@ -0,0 +1,214 @@
+/*******************************************************************************
+  TwiMaster.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "MIDIAccordion.h"
+
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_ASYNC_I2C)
+
+#include <avr/interrupt.h>
+#include <util/twi.h>
+
+#include "TwiMaster.h"
+#include "SharedMacros.h"
+
+// TWCR values; TWINT is written as 1 to clear it, which starts the next bus action.
+static const uint8_t TwcrStart = _BV(TWINT) | _BV(TWSTA) | _BV(TWEN) | _BV(TWIE);
+static const uint8_t TwcrSend = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+static const uint8_t TwcrReadAck = _BV(TWINT) | _BV(TWEA) | _BV(TWEN) | _BV(TWIE);
+static const uint8_t TwcrReadNack = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+static const uint8_t TwcrStop = _BV(TWINT) | _BV(TWSTO) | _BV(TWEN);
+
+// The TwiMaster used by the interrupt; defined in main.cpp.
+extern TwiMaster gTwiMaster;
+
+ISR(TWI_vect)
+{
+  gTwiMaster.OnInterrupt();
+}
+
+TwiMaster::TwiMaster()
+{
+}
+
+// Sets the bit rate with a prescaler of 1; SCL frequency = F_CPU / (16 + 2 * TWBR).
+void TwiMaster::Begin(unsigned long clockHz)
+{
+  mClockHz = clockHz;
+
+  // Enable the internal pull-ups, as the Wire library does.
+  digitalWrite(SDA, HIGH);
+  digitalWrite(SCL, HIGH);
+
+  TWSR = 0;
+  TWBR = ((F_CPU / clockHz) - 16) / 2;
+  TWCR = _BV(TWEN);
+  mStatus = TwiIdle;
+}
+
+bool TwiMaster::StartTransfer(uint8_t address, const uint8_t* writeBytes, uint8_t numWriteBytes, uint8_t numReadBytes)
+{
+  // A stop condition may still be in progress after the last transfer.
+  if (mStatus == TwiBusy || (TWCR & _BV(TWSTO)) != 0 || numWriteBytes > MaxTwiWriteBytes || numReadBytes > MaxTwiReadBytes || numWriteBytes + numReadBytes == 0)
+  {
+    return false;
+  }
+
+  mAddress = address;
+  for (uint8_t i = 0; i < numWriteBytes; i++)
+  {
+    mWriteBytes[i] = writeBytes[i];
+  }
+
+  mNumWriteBytes = numWriteBytes;
+  mNumReadBytesRequested = numReadBytes;
+  mNumBytesWritten = 0;
+  mNumReadBytes = 0;
+  mStartTimeMicroseconds = micros();
+  mStatus = TwiBusy;
+
+  TWCR = TwcrStart;
+  return true;
+}
+
+TwiMaster::Status TwiMaster::Poll()
+{
+  Status status = mStatus;
+  if (status == TwiBusy)
+  {
+    if (micros() - mStartTimeMicroseconds < TwiTimeoutMicroseconds)
+    {
+      return TwiBusy;
+    }
+
+    DBG_PRINT_LN("TwiMaster::Poll() - Transfer to " + String(mAddress) + " timed out; recovering bus.");
+    RecoverBus();
+    status = TwiFailed;
+  }
+
+  if (status != TwiIdle)
+  {
+    mStatus = TwiIdle;
+  }
+
+  return status;
+}
+
+void TwiMaster::OnInterrupt()
+{
+  switch (TW_STATUS)
+  {
+    case TW_START:
+    case TW_REP_START:
+      // Write the bytes first, if any; then read.
+      TWDR = (mAddress << 1) | (mNumBytesWritten < mNumWriteBytes ? TW_WRITE : TW_READ);
+      TWCR = TwcrSend;
+      break;
+
+    case TW_MT_SLA_ACK:
+    case TW_MT_DATA_ACK:
+      if (mNumBytesWritten < mNumWriteBytes)
+      {
+        TWDR = mWriteBytes[mNumBytesWritten++];
+        TWCR = TwcrSend;
+      }
+      else if (mNumReadBytesRequested > 0)
+      {
+        TWCR = TwcrStart;
+      }
+      else
+      {
+        Stop(TwiDone);
+      }
+      break;
+
+    case TW_MR_DATA_ACK:
+      mReadBytes[mNumReadBytes++] = TWDR;
+      // Fall through to acknowledge all but the last byte.
+    case TW_MR_SLA_ACK:
+      TWCR = mNumReadBytes + 1 < mNumReadBytesRequested ? TwcrReadAck : TwcrReadNack;
+      break;
+
+    case TW_MR_DATA_NACK:
+      mReadBytes[mNumReadBytes++] = TWDR;
+      Stop(TwiDone);
+      break;
+
+    case TW_MT_ARB_LOST:
+      // Release the bus; there is no other master.
+      TWCR = _BV(TWINT) | _BV(TWEN);
+      mStatus = TwiFailed;
+      break;
+
+    case TW_MT_SLA_NACK:
+    case TW_MT_DATA_NACK:
+    case TW_MR_SLA_NACK:
+    case TW_BUS_ERROR:
+    default:
+      Stop(TwiFailed);
+      break;
+  }
+}
+
+// Sends a stop condition, and ends the transfer with the status passed in. Called by the interrupt only.
+void TwiMaster::Stop(Status status)
+{
+  TWCR = TwcrStop;
+  mStatus = status;
+}
+
+// Aborts the transfer, and frees the bus. A slave that was sending a 0 bit holds SDA low until it is clocked out;
+// up to 9 SCL pulses finish its byte, and a stop condition resets it. The TWI hardware is then enabled again.
+void TwiMaster::RecoverBus()
+{
+  TWCR = 0;
+  mStatus = TwiFailed;
+
+  pinMode(SDA, INPUT_PULLUP);
+  pinMode(SCL, OUTPUT);
+  digitalWrite(SCL, HIGH);
+  for (uint8_t i = 0; i < 9 && digitalRead(SDA) == LOW; i++)
+  {
+    digitalWrite(SCL, LOW);
+    delayMicroseconds(5);
+    digitalWrite(SCL, HIGH);
+    delayMicroseconds(5);
+  }
+
+  // Stop condition: SDA rises while SCL is high.
+  pinMode(SDA, OUTPUT);
+  digitalWrite(SDA, LOW);
+  delayMicroseconds(5);
+  digitalWrite(SCL, HIGH);
+  delayMicroseconds(5);
+  digitalWrite(SDA, HIGH);
+  delayMicroseconds(5);
+
+  pinMode(SDA, INPUT);
+  pinMode(SCL, INPUT);
+  Begin(mClockHz);
+}
+
+#endif // BUILD_RIGHT_HAND_MASTER && ENABLE_ASYNC_I2C
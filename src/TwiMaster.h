@@ -0,0 +1,92 @@
+/*******************************************************************************
+  TwiMaster.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef TwiMaster_H
+#define TwiMaster_H
+
+#include <Arduino.h>
+
+#include "MIDIAccordion.h"
+#include "SharedConstants.h"
+
+// This class is an interrupt driven TWI (I2C) master, used instead of the Wire library if ENABLE_ASYNC_I2C is defined.
+// StartTransfer() only starts a transfer; the TWI interrupt then moves each byte, and loop() picks up the result with Poll().
+// A transfer writes up to MaxTwiWriteBytes, and then, after a repeated start, reads up to MaxTwiReadBytes.
+// If a transfer does not complete within TwiTimeoutMicroseconds, e.g. because the slave is not connected, or holds SDA low,
+// it is aborted, and the bus is recovered by clocking SCL until the slave releases SDA, and sending a stop condition.
+// The Wire library must not be linked as well, since it uses the same interrupt.
+class TwiMaster
+{
+public:
+  enum Status : uint8_t
+  {
+    TwiIdle,      // No transfer was started since the last result was picked up.
+    TwiBusy,      // The transfer is in progress.
+    TwiDone,      // The transfer completed; the read bytes are available.
+    TwiFailed     // The slave did not acknowledge, the bus failed, or the transfer timed out.
+  };
+
+public:
+  TwiMaster();
+
+  // Enables the TWI hardware as a master, at the clock rate passed in.
+  void Begin(unsigned long clockHz);
+
+  // Starts writing the bytes passed in to the slave, and then reading numReadBytes from it. Returns false if a transfer is in progress.
+  bool StartTransfer(uint8_t address, const uint8_t* writeBytes, uint8_t numWriteBytes, uint8_t numReadBytes);
+
+  // Called by loop() only. Returns the status of the transfer; once TwiDone or TwiFailed is returned, the status returns to TwiIdle.
+  // Aborts the transfer, and recovers the bus, if it timed out.
+  Status Poll();
+
+  // Returns the bytes read by the last completed transfer.
+  const uint8_t* GetReadBytes() { return mReadBytes; }
+  uint8_t GetNumReadBytes() { return mNumReadBytes; }
+
+  // Called by the TWI interrupt only.
+  void OnInterrupt();
+
+protected:
+  void Stop(Status status);
+  void RecoverBus();
+
+private:
+  unsigned long mClockHz = 0;
+  unsigned long mStartTimeMicroseconds = 0;
+
+  uint8_t mAddress = 0;
+  uint8_t mWriteBytes[MaxTwiWriteBytes];
+  uint8_t mNumWriteBytes = 0;
+  uint8_t mReadBytes[MaxTwiReadBytes];
+  uint8_t mNumReadBytesRequested = 0;
+
+  // Written by the interrupt while the status is TwiBusy.
+  volatile uint8_t mNumBytesWritten = 0;
+  volatile uint8_t mNumReadBytes = 0;
+  volatile Status mStatus = TwiIdle;
+};
+
+#endif
@@ -0,0 +1,273 @@
+/*******************************************************************************
+  UartLeftHandLink.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "MIDIAccordion.h"
+
+#ifdef ENABLE_UART_LINK
+
+#include "UartLeftHandLink.h"
+#include "SharedMacros.h"
+#include "Utilities/Crc8.h"
+
+#ifdef BUILD_RIGHT_HAND_MASTER
+
+UartLeftHandLink::UartLeftHandLink()
+{
+}
+
+void UartLeftHandLink::Begin()
+{
+  UART_LINK_SERIAL.begin(LeftHandLinkBaudRate);
+}
+
+// The reply is written by PollReply(), from the frames received by then. The configuration commands are sent to the LH Arduino.
+bool UartLeftHandLink::StartRequest(const uint8_t* commandBytes, uint8_t numCommandBytes, uint8_t numReplyBytes)
+{
+  mCommand = numCommandBytes > 0 ? commandBytes[0] : 0;
+  mNumRequestedBytes = numReplyBytes;
+
+  if (mCommand >= SetLeftHandScanInterval)
+  {
+    if (mCommand == ReadLeftHandStatus)
+    {
+      mNumStatusBytes = 0;
+      mStatusRequestTimeMs = millis();
+    }
+
+    WriteUartLinkFrame(UartLinkCommandFrame, commandBytes, numCommandBytes);
+  }
+
+  return true;
+}
+
+// The commands are written to the UART buffer, and do not fail; a ReadLeftHandStatus request fails once it times out.
+bool UartLeftHandLink::PollReply(const uint8_t*& replyBytes, uint8_t& numReplyBytes, bool& isFailed)
+{
+  ReceiveFrames();
+
+  mNumReplyBytes = 0;
+  switch (mCommand)
+  {
+    case SetLeftHandScanInterval:
+    case SetLeftHandDebounceDelay:
+    case RequestLeftHandSnapshot:
+      // No reply.
+      break;
+
+    case ReadLeftHandStatus:
+      if (!WriteStatusReply())
+      {
+        return false;
+      }
+      break;
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+    case ReadLeftHandEventCount:
+      WriteButtonEventCountReply();
+      break;
+
+    case ReadLeftHandEvents:
+      WriteButtonEventsReply();
+      break;
+#endif // ENABLE_I2C_DELTA_PROTOCOL
+
+    default:
+      WriteSnapshotReply(mNumRequestedBytes);
+      break;
+  }
+
+  replyBytes = mReplyBytes;
+  numReplyBytes = mNumReplyBytes;
+  isFailed = mCommand == ReadLeftHandStatus && mNumReplyBytes == 0;
+  return true;
+}
+
+// Handles the frames received since the last call. A dropped frame may have been a button event, so the snapshot is then stale.
+void UartLeftHandLink::ReceiveFrames()
+{
+  while (UART_LINK_SERIAL.available() > 0)
+  {
+    UartLinkFrameParser::Result result = mFrameParser.Parse(UART_LINK_SERIAL.read());
+    if (result == UartLinkFrameParser::FrameReceived)
+    {
+      HandleFrame();
+    }
+    else if (result == UartLinkFrameParser::FrameDropped)
+    {
+      SetSnapshotStale();
+    }
+  }
+}
+
+void UartLeftHandLink::HandleFrame()
+{
+  uint8_t frameType = mFrameParser.GetFrameType();
+  const uint8_t* payload = mFrameParser.GetPayload();
+  uint8_t numPayloadBytes = mFrameParser.GetNumPayloadBytes();
+
+  if (frameType == UartLinkSnapshotFrame)
+  {
+    for (uint8_t i = 0; i < numPayloadBytes; i++)
+    {
+      mSnapshot[i] = payload[i];
+    }
+
+    mNumSnapshotBytes = numPayloadBytes;
+
+    // The snapshot includes the queued button events, and any lost ones.
+    if (mIsSnapshotStale)
+    {
+      mButtonEvents.Clear();
+      mIsSnapshotStale = false;
+    }
+
+    mNumButtonEventsBeforeSnapshot = mButtonEvents.GetCount();
+    return;
+  }
+
+  if (frameType == UartLinkButtonEventFrame && numPayloadBytes == 1)
+  {
+    if (!mButtonEvents.Push(payload[0]))
+    {
+      SetSnapshotStale();
+    }
+    return;
+  }
+
+  if (frameType == UartLinkStatusFrame)
+  {
+    for (uint8_t i = 0; i < numPayloadBytes; i++)
+    {
+      mStatus[i] = payload[i];
+    }
+
+    mNumStatusBytes = numPayloadBytes;
+  }
+}
+
+// Marks the snapshot stale, and asks the LH Arduino for a new one; once per stale snapshot.
+void UartLeftHandLink::SetSnapshotStale()
+{
+  if (mIsSnapshotStale)
+  {
+    return;
+  }
+
+  mIsSnapshotStale = true;
+
+  uint8_t command = RequestLeftHandSnapshot;
+  WriteUartLinkFrame(UartLinkCommandFrame, &command, 1);
+}
+
+// Replies with the status received since the ReadLeftHandStatus request. Returns false while it may still be received;
+// after UartLinkStatusTimeoutMs, there is no reply.
+bool UartLeftHandLink::WriteStatusReply()
+{
+  if (mNumStatusBytes == 0)
+  {
+    return millis() - mStatusRequestTimeMs >= UartLinkStatusTimeoutMs;
+  }
+
+  for (uint8_t i = 0; i < mNumStatusBytes && i < mNumRequestedBytes; i++)
+  {
+    mReplyBytes[mNumReplyBytes++] = mStatus[i];
+  }
+
+  mNumStatusBytes = 0;
+  return true;
+}
+
+// Replies with the last snapshot, and drops the button events it includes. There is no reply until a snapshot is received,
+// or while the snapshot is stale; the RH Arduino then asks again.
+void UartLeftHandLink::WriteSnapshotReply(uint8_t numRequestedBytes)
+{
+  if (mNumSnapshotBytes != numRequestedBytes || mIsSnapshotStale)
+  {
+    return;
+  }
+
+  for (uint8_t i = 0; i < mNumSnapshotBytes; i++)
+  {
+    mReplyBytes[i] = mSnapshot[i];
+  }
+
+  mNumReplyBytes = mNumSnapshotBytes;
+
+  uint8_t buttonEvent;
+  for (uint8_t i = 0; i < mNumButtonEventsBeforeSnapshot && mButtonEvents.Pop(buttonEvent); i++)
+  {
+  }
+
+  mNumButtonEventsBeforeSnapshot = 0;
+  mNumReportedButtonEvents = 0;
+}
+
+#ifdef ENABLE_I2C_DELTA_PROTOCOL
+
+// Replies with the number of queued button events, up to MaxLeftHandButtonEventsPerFetch, or LeftHandSnapshotRequired.
+void UartLeftHandLink::WriteButtonEventCountReply()
+{
+  if (mIsSnapshotStale)
+  {
+    mNumReportedButtonEvents = 0;
+    mReplyBytes[mNumReplyBytes++] = LeftHandSnapshotRequired;
+    return;
+  }
+
+  uint8_t numButtonEvents = mButtonEvents.GetCount();
+  if (numButtonEvents > MaxLeftHandButtonEventsPerFetch)
+  {
+    numButtonEvents = MaxLeftHandButtonEventsPerFetch;
+  }
+
+  mNumReportedButtonEvents = numButtonEvents;
+  mReplyBytes[mNumReplyBytes++] = numButtonEvents;
+}
+
+// Replies with the button events reported by the last count reply, oldest first, and their CRC-8 with ENABLE_LH_FRAME_CHECK.
+void UartLeftHandLink::WriteButtonEventsReply()
+{
+  uint8_t buttonEvent;
+  for (uint8_t i = 0; i < mNumReportedButtonEvents && mButtonEvents.Pop(buttonEvent); i++)
+  {
+    mReplyBytes[mNumReplyBytes++] = buttonEvent;
+  }
+
+  // The snapshot no longer includes the events just replied.
+  mNumButtonEventsBeforeSnapshot = mNumButtonEventsBeforeSnapshot > mNumReplyBytes ? mNumButtonEventsBeforeSnapshot - mNumReplyBytes : 0;
+  mNumReportedButtonEvents = 0;
+
+#ifdef ENABLE_LH_FRAME_CHECK
+  mReplyBytes[mNumReplyBytes] = Crc8(mReplyBytes, mNumReplyBytes);
+  mNumReplyBytes++;
+#endif
+}
+
+#endif // ENABLE_I2C_DELTA_PROTOCOL
+
+#endif // BUILD_RIGHT_HAND_MASTER
+
+#endif // ENABLE_UART_LINK
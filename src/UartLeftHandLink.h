@@ -0,0 +1,91 @@
+/*******************************************************************************
+  UartLeftHandLink.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef UartLeftHandLink_H
+#define UartLeftHandLink_H
+
+#include <Arduino.h>
+
+#include "MIDIAccordion.h"
+#include "EventQueue.h"
+#include "LeftHandLinkBase.h"
+#include "SharedConstants.h"
+#include "UartLinkFrame.h"
+
+#ifdef BUILD_RIGHT_HAND_MASTER
+
+// This class links the RH Arduino to the LH Arduino over UART, used if ENABLE_UART_LINK is defined.
+// The LH Arduino sends its button changes as frames, without being polled. This class keeps the last snapshot, and the button events,
+// received since, and answers each request from them at once, as the LH Arduino answers it over I2C; see LeftHandSetupManager.
+// A snapshot includes the button events received before it; once it is read, only the button events received after it are replied.
+// If a button event is lost, i.e. the queue is full, or a frame is corrupted, the snapshot is stale until the next one is received;
+// the LH Arduino is then sent RequestLeftHandSnapshot, so that it does not take until the next keep-alive.
+// The configuration commands are sent as command frames; ReadLeftHandStatus is the only request that waits for the LH Arduino.
+class UartLeftHandLink : public LeftHandLinkBase
+{
+public:
+  UartLeftHandLink();
+
+  void Begin();
+  bool StartRequest(const uint8_t* commandBytes, uint8_t numCommandBytes, uint8_t numReplyBytes);
+  bool PollReply(const uint8_t*& replyBytes, uint8_t& numReplyBytes, bool& isFailed);
+
+protected:
+  void ReceiveFrames();
+  void HandleFrame();
+  void SetSnapshotStale();
+  bool WriteStatusReply();
+  void WriteSnapshotReply(uint8_t numRequestedBytes);
+  void WriteButtonEventCountReply();
+  void WriteButtonEventsReply();
+
+private:
+  UartLinkFrameParser mFrameParser;
+
+  // The last snapshot received, and the number of queued button events received before it.
+  uint8_t mSnapshot[MaxUartLinkPayloadBytes];
+  uint8_t mNumSnapshotBytes = 0;
+  uint8_t mNumButtonEventsBeforeSnapshot = 0;
+  bool mIsSnapshotStale = false;
+
+  EventQueue<uint8_t, LeftHandButtonEventQueueSize> mButtonEvents;
+  uint8_t mNumReportedButtonEvents = 0;
+
+  // The request in progress, and its reply.
+  uint8_t mCommand = 0;
+  uint8_t mNumRequestedBytes = 0;
+  uint8_t mReplyBytes[MaxLeftHandReplyBytes];
+  uint8_t mNumReplyBytes = 0;
+
+  // The last status received, and the millis() time of the ReadLeftHandStatus request in progress.
+  uint8_t mStatus[MaxUartLinkPayloadBytes];
+  uint8_t mNumStatusBytes = 0;
+  unsigned long mStatusRequestTimeMs = 0;
+};
+
+#endif // BUILD_RIGHT_HAND_MASTER
+
+#endif
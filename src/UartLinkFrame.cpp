@@ -0,0 +1,150 @@
+/*******************************************************************************
+  UartLinkFrame.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "MIDIAccordion.h"
+
+#ifdef ENABLE_UART_LINK
+
+#include "UartLinkFrame.h"
+#include "SharedMacros.h"
+#include "Utilities/Crc8.h"
+
+// Writes the byte passed in, escaped if it is UartLinkFrameSync, or UartLinkFrameEscape.
+static void WriteUartLinkFrameByte(uint8_t value)
+{
+  if (value == UartLinkFrameSync || value == UartLinkFrameEscape)
+  {
+    UART_LINK_SERIAL.write(UartLinkFrameEscape);
+    value ^= UartLinkFrameEscapeMask;
+  }
+
+  UART_LINK_SERIAL.write(value);
+}
+
+void WriteUartLinkFrame(UartLinkFrameType frameType, const uint8_t* payload, uint8_t numPayloadBytes)
+{
+  uint8_t header[] = {(uint8_t)frameType, numPayloadBytes};
+  uint8_t crc = Crc8(header, sizeof(header));
+  crc = Crc8(payload, numPayloadBytes, crc);
+
+  UART_LINK_SERIAL.write(UartLinkFrameSync);
+  WriteUartLinkFrameByte(header[0]);
+  WriteUartLinkFrameByte(header[1]);
+  for (uint8_t i = 0; i < numPayloadBytes; i++)
+  {
+    WriteUartLinkFrameByte(payload[i]);
+  }
+
+  WriteUartLinkFrameByte(crc);
+}
+
+UartLinkFrameParser::UartLinkFrameParser()
+{
+}
+
+// A sync byte always starts a frame; so a frame cut short by a lost byte is dropped, and the next one is received.
+UartLinkFrameParser::Result UartLinkFrameParser::Parse(uint8_t receivedByte)
+{
+  if (receivedByte == UartLinkFrameSync)
+  {
+    bool isFrameCutShort = mParserState != WaitingForSync;
+    mParserState = ReadingFrameType;
+    mIsEscaped = false;
+    if (isFrameCutShort)
+    {
+      DBG_PRINT_LN("UartLinkFrameParser::Parse() - Frame cut short by a sync byte; dropped.");
+      return FrameDropped;
+    }
+
+    return NoFrame;
+  }
+
+  if (mParserState == WaitingForSync)
+  {
+    return NoFrame;
+  }
+
+  if (receivedByte == UartLinkFrameEscape)
+  {
+    mIsEscaped = true;
+    return NoFrame;
+  }
+
+  if (mIsEscaped)
+  {
+    receivedByte ^= UartLinkFrameEscapeMask;
+    mIsEscaped = false;
+  }
+
+  switch (mParserState)
+  {
+    case WaitingForSync:
+      break;
+
+    case ReadingFrameType:
+      mFrameType = receivedByte;
+      mCrc = Crc8(&receivedByte, 1);
+      mParserState = ReadingPayloadLength;
+      break;
+
+    case ReadingPayloadLength:
+      if (receivedByte > MaxUartLinkPayloadBytes)
+      {
+        DBG_PRINT_LN("UartLinkFrameParser::Parse() - Bad payload length = " + String(receivedByte) + ".");
+        mParserState = WaitingForSync;
+        return FrameDropped;
+      }
+
+      mNumPayloadBytes = receivedByte;
+      mNumPayloadBytesReceived = 0;
+      mCrc = Crc8(&receivedByte, 1, mCrc);
+      mParserState = mNumPayloadBytes > 0 ? ReadingPayload : ReadingCrc;
+      break;
+
+    case ReadingPayload:
+      mPayload[mNumPayloadBytesReceived++] = receivedByte;
+      mCrc = Crc8(&receivedByte, 1, mCrc);
+      if (mNumPayloadBytesReceived == mNumPayloadBytes)
+      {
+        mParserState = ReadingCrc;
+      }
+      break;
+
+    case ReadingCrc:
+      mParserState = WaitingForSync;
+      if (receivedByte != mCrc)
+      {
+        DBG_PRINT_LN("UartLinkFrameParser::Parse() - Corrupted frame dropped.");
+        return FrameDropped;
+      }
+
+      return FrameReceived;
+  }
+
+  return NoFrame;
+}
+
+#endif // ENABLE_UART_LINK
@@ -0,0 +1,82 @@
+/*******************************************************************************
+  UartLinkFrame.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef UartLinkFrame_H
+#define UartLinkFrame_H
+
+#include <Arduino.h>
+
+#include "SharedConstants.h"
+
+// The serial port of the UART link, on both Arduinos.
+#define UART_LINK_SERIAL Serial2
+
+// Writes a UART link frame of the type, and payload, passed in; escaping the bytes after the sync byte, see UartLinkFrameEscape.
+void WriteUartLinkFrame(UartLinkFrameType frameType, const uint8_t* payload, uint8_t numPayloadBytes);
+
+// This class parses the UART link frames received, one byte at a time. Used by both Arduinos.
+// A frame with a bad length, or CRC-8, or cut short by a sync byte, is dropped; the parser then waits for the next sync byte.
+class UartLinkFrameParser
+{
+public:
+  enum Result : uint8_t
+  {
+    NoFrame,
+    FrameReceived,
+    FrameDropped
+  };
+
+  UartLinkFrameParser();
+
+  // Parses the byte passed in; returns FrameReceived once it completes a frame, whose type and payload are then valid until the next call.
+  Result Parse(uint8_t receivedByte);
+
+  uint8_t GetFrameType() const { return mFrameType; }
+  const uint8_t* GetPayload() const { return mPayload; }
+  uint8_t GetNumPayloadBytes() const { return mNumPayloadBytes; }
+
+private:
+  enum ParserState : uint8_t
+  {
+    WaitingForSync,
+    ReadingFrameType,
+    ReadingPayloadLength,
+    ReadingPayload,
+    ReadingCrc
+  };
+
+  ParserState mParserState = WaitingForSync;
+  uint8_t mFrameType = 0;
+  uint8_t mNumPayloadBytes = 0;
+  uint8_t mNumPayloadBytesReceived = 0;
+  uint8_t mPayload[MaxUartLinkPayloadBytes];
+  uint8_t mCrc = 0;
+
+  // The last byte received was UartLinkFrameEscape; the next one is XORed with UartLinkFrameEscapeMask.
+  bool mIsEscaped = false;
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*******************************************************************************
+  Crc8.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "Crc8.h"
+#include "../SharedConstants.h"
+
+uint8_t Crc8(const uint8_t* bytes, uint8_t numBytes, uint8_t crc)
+{
+  for (uint8_t i = 0; i < numBytes; i++)
+  {
+    crc ^= bytes[i];
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+      crc = (crc & 0x80) != 0 ? (crc << 1) ^ Crc8Polynomial : crc << 1;
+    }
+  }
+
+  return crc;
+}
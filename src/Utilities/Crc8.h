@@ -1,5 +1,5 @@
 /*******************************************************************************
-  ButtonState.h
+  Crc8.h
   
   MIDI Electronic Accordion
   https://github.com/BarryKVibes/MidiElectronicAccordion
@@ -24,19 +24,12 @@
   
  ******************************************************************************/
 
-#ifndef ButtonState_H
-#define ButtonState_H
+#ifndef Crc8_H
+#define Crc8_H
 
 #include <Arduino.h>
 
-// The ButtonState structure contains an indication whether the button is pressed, and its pin number.
-typedef struct
-{
-    uint32_t    active    :  1; //  1 false/true
-    uint32_t    pin       :  7; //  8 0 - 127
-    uint32_t    unused0   : 10; // 18 0 - 1023
-    uint32_t    unused1   :  7; // 25 0 - 127
-    uint32_t    unused2   :  7; // 32 0 - 127
-} ButtonState;
+// Returns the CRC-8 (Crc8Polynomial) of the bytes passed in. Pass the result of a previous call as crc to continue it.
+uint8_t Crc8(const uint8_t* bytes, uint8_t numBytes, uint8_t crc = 0);
 
 #endif
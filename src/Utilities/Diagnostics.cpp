@@ -57,4 +57,80 @@ void Diagnostics::LogLoopTime()
   mLastLoopStartTimeMicroseconds = curMicrosseconds;
 }
 
+// Accumulates the time taken to scan the RH buttons, and prints the average and maximum scan time every 100 scans.
+// Use this to compare the digitalRead() scan against the port register scan (ENABLE_PORT_REGISTER_SCAN).
+void Diagnostics::LogScanTime(unsigned long scanStartTimeMicroseconds)
+{
+  unsigned long scanTimeMicroseconds = micros() - scanStartTimeMicroseconds;
+  mTotalScanTimeMicroseconds += scanTimeMicroseconds;
+  if (scanTimeMicroseconds > mMaxScanTimeMicroseconds)
+  {
+    mMaxScanTimeMicroseconds = scanTimeMicroseconds;
+  }
+
+  mNumScans++;
+  if (mNumScans >= 100)
+  {
+    unsigned long avgScanTimeMicroseconds = mTotalScanTimeMicroseconds / mNumScans;
+    DBG_PRINT_LN("Avg scan time = " + String(avgScanTimeMicroseconds) + " Microseconds; Max scan time = " + String(mMaxScanTimeMicroseconds) + " Microseconds");
+
+    mNumScans = 0;
+    mTotalScanTimeMicroseconds = 0;
+    mMaxScanTimeMicroseconds = 0;
+  }
+}
+
+// Accumulates the time from when a button change was sampled until now, and prints the average and maximum latency every 100 events.
+void Diagnostics::LogButtonEventLatency(const ButtonEvent& buttonEvent)
+{
+  unsigned long latencyMicroseconds = micros() - buttonEvent.timeMicroseconds;
+  mTotalButtonEventLatencyMicroseconds += latencyMicroseconds;
+  if (latencyMicroseconds > mMaxButtonEventLatencyMicroseconds)
+  {
+    mMaxButtonEventLatencyMicroseconds = latencyMicroseconds;
+  }
+
+  mNumButtonEvents++;
+  if (mNumButtonEvents >= 100)
+  {
+    unsigned long avgButtonEventLatencyMicroseconds = mTotalButtonEventLatencyMicroseconds / mNumButtonEvents;
+    DBG_PRINT_LN("Avg button event latency = " + String(avgButtonEventLatencyMicroseconds) + " Microseconds; Max button event latency = " + String(mMaxButtonEventLatencyMicroseconds) + " Microseconds");
+
+    mNumButtonEvents = 0;
+    mTotalButtonEventLatencyMicroseconds = 0;
+    mMaxButtonEventLatencyMicroseconds = 0;
+  }
+}
+
+// Accumulates the time from the start of the ScanFrame passed in until now, and the number of button events in the frame.
+// Prints the average and maximum frame time, and button events per frame, every 100 frames.
+void Diagnostics::LogFrameTime(const ScanFrame& scanFrame)
+{
+  unsigned long frameTimeMicroseconds = micros() - scanFrame.timeMicroseconds;
+  mTotalFrameTimeMicroseconds += frameTimeMicroseconds;
+  if (frameTimeMicroseconds > mMaxFrameTimeMicroseconds)
+  {
+    mMaxFrameTimeMicroseconds = frameTimeMicroseconds;
+  }
+
+  mTotalFrameButtonEvents += scanFrame.totalButtonEvents;
+  if (scanFrame.totalButtonEvents > mMaxFrameButtonEvents)
+  {
+    mMaxFrameButtonEvents = scanFrame.totalButtonEvents;
+  }
+
+  mNumFrames++;
+  if (mNumFrames >= 100)
+  {
+    unsigned long avgFrameTimeMicroseconds = mTotalFrameTimeMicroseconds / mNumFrames;
+    DBG_PRINT_LN("Avg frame time = " + String(avgFrameTimeMicroseconds) + " Microseconds; Max frame time = " + String(mMaxFrameTimeMicroseconds) + " Microseconds; Button events per 100 frames = " + String(mTotalFrameButtonEvents) + "; Max per frame = " + String(mMaxFrameButtonEvents));
+
+    mNumFrames = 0;
+    mTotalFrameTimeMicroseconds = 0;
+    mMaxFrameTimeMicroseconds = 0;
+    mTotalFrameButtonEvents = 0;
+    mMaxFrameButtonEvents = 0;
+  }
+}
+
 #endif // SEND_MIDI
\ No newline at end of file
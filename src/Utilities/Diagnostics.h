@@ -29,6 +29,9 @@
 
 #include <Arduino.h>
 
+#include "../ButtonEvent.h"
+#include "../ScanFrame.h"
+
 class Diagnostics {
 
 private:
@@ -38,10 +41,27 @@ private:
   const int MaxLoops = 100;
   unsigned int mNumLoops;
 
+  unsigned long mTotalScanTimeMicroseconds = 0;
+  unsigned long mMaxScanTimeMicroseconds = 0;
+  unsigned int mNumScans = 0;
+
+  unsigned long mTotalButtonEventLatencyMicroseconds = 0;
+  unsigned long mMaxButtonEventLatencyMicroseconds = 0;
+  unsigned int mNumButtonEvents = 0;
+
+  unsigned long mTotalFrameTimeMicroseconds = 0;
+  unsigned long mMaxFrameTimeMicroseconds = 0;
+  unsigned int mTotalFrameButtonEvents = 0;
+  uint8_t mMaxFrameButtonEvents = 0;
+  unsigned int mNumFrames = 0;
+
 public:
   Diagnostics();
 
   void LogLoopTime();
+  void LogScanTime(unsigned long scanStartTimeMicroseconds);
+  void LogButtonEventLatency(const ButtonEvent& buttonEvent);
+  void LogFrameTime(const ScanFrame& scanFrame);
 };
 
 #endif
@@ -0,0 +1,186 @@
+/*******************************************************************************
+  I2CTelemetry.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "../MIDIAccordion.h"
+
+#ifdef BUILD_RIGHT_HAND_MASTER
+
+#include "../SharedMacros.h"
+#include "I2CTelemetry.h"
+#include "SysExReportQueue.h"
+
+extern SysExReportQueue gSysExReportQueue;
+
+I2CTelemetry::I2CTelemetry()
+{
+  Reset();
+}
+
+void I2CTelemetry::LogFetch(unsigned long fetchTimeMicroseconds)
+{
+  uint16_t fetchTime = fetchTimeMicroseconds < 0xFFFF ? fetchTimeMicroseconds : 0xFFFF;
+
+  // Halve the counts before they overflow; the averages, and the shape of the histogram, are kept.
+  if (mNumFetches == 0xFFFF)
+  {
+    for (uint8_t i = 0; i < I2CTelemetryNumBuckets; i++)
+    {
+      mFetchTimeHistogram[i] /= 2;
+    }
+
+    mNumFetches /= 2;
+    mTotalFetchTimeMicroseconds /= 2;
+  }
+
+  uint16_t bucket = fetchTime / I2CTelemetryBucketMicroseconds;
+  if (bucket >= I2CTelemetryNumBuckets)
+  {
+    bucket = I2CTelemetryNumBuckets - 1;
+  }
+
+  mFetchTimeHistogram[bucket]++;
+  mTotalFetchTimeMicroseconds += fetchTime;
+  mNumFetches++;
+
+  if (fetchTime < mMinFetchTimeMicroseconds)
+  {
+    mMinFetchTimeMicroseconds = fetchTime;
+  }
+
+  if (fetchTime > mMaxFetchTimeMicroseconds)
+  {
+    mMaxFetchTimeMicroseconds = fetchTime;
+  }
+}
+
+void I2CTelemetry::LogShortRead()
+{
+  if (mNumShortReads < 0xFFFF)
+  {
+    mNumShortReads++;
+  }
+}
+
+void I2CTelemetry::LogCorruptFrame()
+{
+  if (mNumCorruptFrames < 0xFFFF)
+  {
+    mNumCorruptFrames++;
+  }
+}
+
+void I2CTelemetry::Reset()
+{
+  for (uint8_t i = 0; i < I2CTelemetryNumBuckets; i++)
+  {
+    mFetchTimeHistogram[i] = 0;
+  }
+
+  mTotalFetchTimeMicroseconds = 0;
+  mNumFetches = 0;
+  mNumShortReads = 0;
+  mNumCorruptFrames = 0;
+  mMinFetchTimeMicroseconds = 0xFFFF;
+  mMaxFetchTimeMicroseconds = 0;
+}
+
+uint16_t I2CTelemetry::GetAverageFetchTimeMicroseconds()
+{
+  return mNumFetches > 0 ? mTotalFetchTimeMicroseconds / mNumFetches : 0;
+}
+
+// Returns the upper bound of the histogram bucket that holds the fetch at the percentile passed in; at most the max fetch time.
+uint16_t I2CTelemetry::GetPercentileFetchTimeMicroseconds(uint8_t percent)
+{
+  if (mNumFetches == 0)
+  {
+    return 0;
+  }
+
+  uint32_t rank = ((uint32_t)mNumFetches * percent + 99) / 100;
+  uint32_t numFetches = 0;
+  for (uint8_t i = 0; i < I2CTelemetryNumBuckets; i++)
+  {
+    numFetches += mFetchTimeHistogram[i];
+    if (numFetches >= rank)
+    {
+      uint32_t bucketEndMicroseconds = (uint32_t)(i + 1) * I2CTelemetryBucketMicroseconds;
+      return bucketEndMicroseconds < mMaxFetchTimeMicroseconds ? bucketEndMicroseconds : mMaxFetchTimeMicroseconds;
+    }
+  }
+
+  return mMaxFetchTimeMicroseconds;
+}
+
+// The SysEx message is:
+// F0 7D 01 <clock kHz> <fetches> <short reads> <min us> <avg us> <p99 us> <max us> <corrupted replies> F7
+// where each value is 2 data bytes, most significant 7 bits first.
+void I2CTelemetry::Report()
+{
+  uint16_t values[] = {
+    (uint16_t)(I2CClockHz / 1000),
+    mNumFetches,
+    mNumShortReads,
+    GetMinFetchTimeMicroseconds(),
+    GetAverageFetchTimeMicroseconds(),
+    GetPercentileFetchTimeMicroseconds(99),
+    mMaxFetchTimeMicroseconds,
+    mNumCorruptFrames
+    };
+
+#ifdef SEND_MIDI
+  gSysExReportQueue.Add(I2CTelemetrySysExType, values, sizeof(values) / sizeof(values[0]));
+#else
+  DBG_PRINT_LN("I2CTelemetry::Report() - Clock = " + String(values[0]) + " kHz, Fetches = " + String(values[1]) + ", Short reads = " + String(values[2]) + ", Corrupted replies = " + String(values[7]) + ".");
+  DBG_PRINT_LN("I2CTelemetry::Report() - Fetch time: min = " + String(values[3]) + ", avg = " + String(values[4]) + ", p99 = " + String(values[5]) + ", max = " + String(values[6]) + " Microseconds.");
+#endif // SEND_MIDI
+}
+
+// The SysEx message is:
+// F0 7D 02 <version major> <version minor> <scan interval us> <debounce ms> <scans> <avg scan us> <max scan us> F7
+// where each value is 2 data bytes, as for Report(); the scan statistics are of the last LeftHandScanStatsWindowMs window.
+void I2CTelemetry::ReportLeftHandStatus(const uint8_t* statusBytes)
+{
+  uint16_t values[] = {
+    statusBytes[LeftHandStatusVersionMajor],
+    statusBytes[LeftHandStatusVersionMinor],
+    word(statusBytes[LeftHandStatusScanIntervalHigh], statusBytes[LeftHandStatusScanIntervalLow]),
+    statusBytes[LeftHandStatusDebounceDelay],
+    word(statusBytes[LeftHandStatusNumScansHigh], statusBytes[LeftHandStatusNumScansLow]),
+    word(statusBytes[LeftHandStatusAverageScanTimeHigh], statusBytes[LeftHandStatusAverageScanTimeLow]),
+    word(statusBytes[LeftHandStatusMaxScanTimeHigh], statusBytes[LeftHandStatusMaxScanTimeLow]),
+    word(statusBytes[LeftHandStatusUptimeHigh], statusBytes[LeftHandStatusUptimeLow])
+    };
+
+#ifdef SEND_MIDI
+  gSysExReportQueue.Add(LeftHandStatusSysExType, values, sizeof(values) / sizeof(values[0]));
+#else
+  DBG_PRINT_LN("I2CTelemetry::ReportLeftHandStatus() - LH firmware " + String(values[0]) + "." + String(values[1]) + ", Scan interval = " + String(values[2]) + " Microseconds, Debounce delay = " + String(values[3]) + " ms.");
+  DBG_PRINT_LN("I2CTelemetry::ReportLeftHandStatus() - Scans = " + String(values[4]) + ", Scan time: avg = " + String(values[5]) + ", max = " + String(values[6]) + " Microseconds, Uptime = " + String(values[7]) + " s.");
+#endif // SEND_MIDI
+}
+
+#endif // BUILD_RIGHT_HAND_MASTER
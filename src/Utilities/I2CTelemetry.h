@@ -0,0 +1,78 @@
+/*******************************************************************************
+  I2CTelemetry.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef I2CTelemetry_H
+#define I2CTelemetry_H
+
+#include <Arduino.h>
+
+#include "../SharedConstants.h"
+
+// This class keeps statistics of the fetches of the LH button states over I2C, and reports them, and the status of the LH Arduino; min, average, 99th percentile, and max fetch time,
+// and the number of short reads, and corrupted replies. It is built into every RH build, including SEND_MIDI builds, so the effect of I2CClockHz, and of
+// the bus wiring, can be measured on the instrument. It uses fixed memory, and no Strings, so it may run all the time.
+// The 99th percentile is taken from a histogram, so it is rounded up to I2CTelemetryBucketMicroseconds.
+class I2CTelemetry
+{
+public:
+  I2CTelemetry();
+
+  // Called when a fetch completed; with the time from the start of its first request.
+  void LogFetch(unsigned long fetchTimeMicroseconds);
+
+  // Called when the LH Arduino replied with fewer bytes than requested, or the request failed.
+  void LogShortRead();
+
+  // Called when a reply failed its CRC-8 check; see ENABLE_LH_FRAME_CHECK.
+  void LogCorruptFrame();
+
+  void Reset();
+
+  uint16_t GetNumFetches() { return mNumFetches; }
+  uint16_t GetNumShortReads() { return mNumShortReads; }
+  uint16_t GetNumCorruptFrames() { return mNumCorruptFrames; }
+  uint16_t GetMinFetchTimeMicroseconds() { return mNumFetches > 0 ? mMinFetchTimeMicroseconds : 0; }
+  uint16_t GetMaxFetchTimeMicroseconds() { return mMaxFetchTimeMicroseconds; }
+  uint16_t GetAverageFetchTimeMicroseconds();
+  uint16_t GetPercentileFetchTimeMicroseconds(uint8_t percent);
+
+  // Sends the statistics as a SysEx message, through gSysExReportQueue, if SEND_MIDI is defined, otherwise prints them.
+  void Report();
+
+  // Sends the ReadLeftHandStatus reply passed in, the same way; see LeftHandStatusByte.
+  void ReportLeftHandStatus(const uint8_t* statusBytes);
+
+private:
+  uint16_t mFetchTimeHistogram[I2CTelemetryNumBuckets];
+  uint32_t mTotalFetchTimeMicroseconds = 0;
+  uint16_t mNumFetches = 0;
+  uint16_t mNumShortReads = 0;
+  uint16_t mNumCorruptFrames = 0;
+  uint16_t mMinFetchTimeMicroseconds = 0xFFFF;
+  uint16_t mMaxFetchTimeMicroseconds = 0;
+};
+
+#endif
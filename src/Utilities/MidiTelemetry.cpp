@@ -0,0 +1,135 @@
+/*******************************************************************************
+  MidiTelemetry.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "../MIDIAccordion.h"
+
+#ifdef BUILD_RIGHT_HAND_MASTER
+
+#include "../lib/ArduMidi/ardumidi.h"
+
+#include "../SharedMacros.h"
+#include "../MidiBandwidthMeter.h"
+#include "MidiTelemetry.h"
+#include "SysExReportQueue.h"
+#ifdef ENABLE_MIDI_TRANSMIT_QUEUE
+#include "../MidiTransmitQueue.h"
+
+extern MidiTransmitQueue gMidiTransmitQueue;
+#endif
+
+extern MidiBandwidthMeter gMidiBandwidthMeter;
+extern SysExReportQueue gSysExReportQueue;
+
+MidiTelemetry::MidiTelemetry()
+{
+}
+
+void MidiTelemetry::Report()
+{
+  ReportByteCounts();
+  ReportBandwidth();
+#ifdef ENABLE_MIDI_TRANSMIT_QUEUE
+  ReportTransmitQueue();
+#endif
+}
+
+// The SysEx message is:
+// F0 7D 03 <messages> <bytes> <status bytes omitted> F7
+// where each count is 4 data bytes, most significant 7 bits first; i.e. 2 values, of the high, and low, 14 bits.
+// The counts are read before the message is sent, so they do not include it.
+void MidiTelemetry::ReportByteCounts()
+{
+  unsigned long counts[] = {
+    midi_get_messages_sent(),
+    midi_get_bytes_sent(),
+    midi_get_status_bytes_omitted()
+    };
+
+  midi_reset_byte_counts();
+
+#ifdef SEND_MIDI
+  const uint8_t NumCounts = sizeof(counts) / sizeof(counts[0]);
+  uint16_t values[2 * NumCounts];
+  for (uint8_t i = 0; i < NumCounts; i++)
+  {
+    values[2 * i] = (counts[i] >> 14) & MaxSysExReportValue;
+    values[2 * i + 1] = counts[i] & MaxSysExReportValue;
+  }
+
+  gSysExReportQueue.Add(MidiByteCountsSysExType, values, 2 * NumCounts);
+#else
+  DBG_PRINT_LN("MidiTelemetry::ReportByteCounts() - Messages = " + String(counts[0]) + ", Bytes = " + String(counts[1]) + ", Status bytes omitted = " + String(counts[2]) + ".");
+#endif // SEND_MIDI
+}
+
+// The SysEx message is:
+// F0 7D 05 <window ms> <last window %> <peak %> <average %> <volume back-offs> F7
+// where each value is 2 data bytes, most significant 7 bits first.
+void MidiTelemetry::ReportBandwidth()
+{
+  uint16_t values[] = {
+    MidiBandwidthWindowMs,
+    gMidiBandwidthMeter.GetLastWindowUtilizationPercent(),
+    gMidiBandwidthMeter.GetPeakUtilizationPercent(),
+    gMidiBandwidthMeter.GetAverageUtilizationPercent(),
+    gMidiBandwidthMeter.GetNumBackOffs()
+    };
+
+  gMidiBandwidthMeter.ResetStatistics();
+
+#ifdef SEND_MIDI
+  gSysExReportQueue.Add(MidiBandwidthSysExType, values, sizeof(values) / sizeof(values[0]));
+#else
+  DBG_PRINT_LN("MidiTelemetry::ReportBandwidth() - Utilization per " + String(values[0]) + " ms: last = " + String(values[1]) + "%, peak = " + String(values[2]) + "%, average = " + String(values[3]) + "%; Volume back-offs = " + String(values[4]) + ".");
+#endif // SEND_MIDI
+}
+
+#ifdef ENABLE_MIDI_TRANSMIT_QUEUE
+// The SysEx message is:
+// F0 7D 04 <note high-water> <control change high-water> <blocking writes> <control changes coalesced> <messages deferred> F7
+// where each value is 2 data bytes, most significant 7 bits first.
+void MidiTelemetry::ReportTransmitQueue()
+{
+  uint16_t values[] = {
+    gMidiTransmitQueue.GetHighWaterMark(MidiNotePriority),
+    gMidiTransmitQueue.GetHighWaterMark(MidiControlChangePriority),
+    gMidiTransmitQueue.GetNumBlockingWrites(),
+    gMidiTransmitQueue.GetNumCoalescedControlChanges(),
+    gMidiTransmitQueue.GetNumDeferredMessages()
+    };
+
+  gMidiTransmitQueue.ResetStatistics();
+
+#ifdef SEND_MIDI
+  gSysExReportQueue.Add(MidiTransmitQueueSysExType, values, sizeof(values) / sizeof(values[0]));
+#else
+  DBG_PRINT_LN("MidiTelemetry::ReportTransmitQueue() - High-water: notes = " + String(values[0]) + ", control changes = " + String(values[1]) + "; Blocking writes = " + String(values[2]) + ".");
+  DBG_PRINT_LN("MidiTelemetry::ReportTransmitQueue() - Coalesced control changes = " + String(values[3]) + ", Deferred messages = " + String(values[4]) + ".");
+#endif // SEND_MIDI
+}
+#endif // ENABLE_MIDI_TRANSMIT_QUEUE
+
+#endif // BUILD_RIGHT_HAND_MASTER
@@ -0,0 +1,58 @@
+/*******************************************************************************
+  MidiTelemetry.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef MidiTelemetry_H
+#define MidiTelemetry_H
+
+#include <Arduino.h>
+
+#include "../SharedConstants.h"
+
+// This class reports the statistics of the MIDI out; the byte counts of ArduMidi, the utilization measured by MidiBandwidthMeter,
+// and, if ENABLE_MIDI_TRANSMIT_QUEUE is defined, those of MidiTransmitQueue. Each report reads the statistics of one source,
+// and resets them, so the reports may be sent in any order. They are sent as SysEx messages, through gSysExReportQueue,
+// if SEND_MIDI is defined, otherwise printed.
+class MidiTelemetry
+{
+public:
+  MidiTelemetry();
+
+  // Sends all the reports, and resets their statistics. Called by ToneButtonRole::SendTelemetry.
+  void Report();
+
+private:
+  // The MIDI out byte counts since the last report. Reporting before, and after, playing a passage measures its bytes;
+  // e.g. with, and without, ENABLE_MIDI_RUNNING_STATUS, or ENABLE_NOTE_OFF_AS_VELOCITY_ZERO.
+  void ReportByteCounts();
+
+  // The MIDI out utilization, and the number of volume changes held back while it was busy.
+  void ReportBandwidth();
+
+  // The high-water marks, and counts, of the MIDI transmit queue.
+  void ReportTransmitQueue();
+};
+
+#endif
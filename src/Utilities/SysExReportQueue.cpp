@@ -0,0 +1,103 @@
+/*******************************************************************************
+  SysExReportQueue.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#include "../MIDIAccordion.h"
+
+#ifdef BUILD_RIGHT_HAND_MASTER
+
+#include "../lib/ArduMidi/ardumidi.h"
+
+#include "../SharedMacros.h"
+#include "SysExReportQueue.h"
+#ifdef ENABLE_MIDI_TRANSMIT_QUEUE
+#include "../MidiTransmitQueue.h"
+
+extern MidiTransmitQueue gMidiTransmitQueue;
+#endif
+
+// The bytes of a SysEx message besides its values; F0, the manufacturer ID, the type, and F7.
+static const uint8_t NumSysExFramingBytes = 4;
+
+SysExReportQueue::SysExReportQueue()
+{
+}
+
+bool SysExReportQueue::Add(uint8_t sysExType, const uint16_t* values, uint8_t numValues)
+{
+  SysExReport report;
+  report.sysExType = sysExType;
+  report.numValues = numValues < MaxSysExReportValues ? numValues : MaxSysExReportValues;
+  for (uint8_t i = 0; i < report.numValues; i++)
+  {
+    report.values[i] = values[i];
+  }
+
+  if (!mReports.Push(report))
+  {
+    DBG_PRINT_LN("SysExReportQueue::Add() - Queue full; dropped the report of type " + String(sysExType) + ".");
+    return false;
+  }
+
+  return true;
+}
+
+void SysExReportQueue::Update()
+{
+  if (mReports.IsEmpty())
+  {
+    return;
+  }
+
+#ifdef ENABLE_MIDI_TRANSMIT_QUEUE
+  if (!gMidiTransmitQueue.IsIdle())
+  {
+    return;
+  }
+#endif
+
+  const SysExReport& report = mReports.Peek();
+  if (Serial.availableForWrite() < NumSysExFramingBytes + 2 * report.numValues)
+  {
+    return;
+  }
+
+  byte sysExData[2 + 2 * MaxSysExReportValues];
+  uint8_t numBytes = 0;
+  sysExData[numBytes++] = NonCommercialSysExId;
+  sysExData[numBytes++] = report.sysExType;
+  for (uint8_t i = 0; i < report.numValues; i++)
+  {
+    uint16_t value = report.values[i] < MaxSysExReportValue ? report.values[i] : MaxSysExReportValue;
+    sysExData[numBytes++] = value >> 7;
+    sysExData[numBytes++] = value & 0x7F;
+  }
+
+  SysExReport sentReport;
+  mReports.Pop(sentReport);
+  midi_system_exclusive(sysExData, numBytes);
+}
+
+#endif // BUILD_RIGHT_HAND_MASTER
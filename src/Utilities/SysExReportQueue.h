@@ -0,0 +1,62 @@
+/*******************************************************************************
+  SysExReportQueue.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef SysExReportQueue_H
+#define SysExReportQueue_H
+
+#include <Arduino.h>
+
+#include "../EventQueue.h"
+#include "../SharedConstants.h"
+
+// A telemetry report; its SysEx type, and its values, taken when it was added.
+struct SysExReport
+{
+  uint8_t sysExType;
+  uint8_t numValues;
+  uint16_t values[MaxSysExReportValues];
+};
+
+// This class queues the telemetry reports, and sends them as SysEx messages, at most one per pass of loop(), and only once
+// the whole message fits in the Serial TX buffer; with ENABLE_MIDI_TRANSMIT_QUEUE, also only once no MIDI message is waiting.
+// So a burst of reports, e.g. from ToneButtonRole::SendTelemetry during play, never blocks loop(), nor delays a note.
+// Each SysEx message is: F0 7D <type> <values> F7, where each value is 2 data bytes, most significant 7 bits first, saturating at 0x3FFF.
+class SysExReportQueue
+{
+public:
+  SysExReportQueue();
+
+  // Queues the report passed in; returns false, and drops it, if the queue is full.
+  bool Add(uint8_t sysExType, const uint16_t* values, uint8_t numValues);
+
+  // Sends the oldest report, if it fits. Called by loop().
+  void Update();
+
+private:
+  EventQueue<SysExReport, SysExReportQueueSize> mReports;
+};
+
+#endif
@@ -79,14 +79,14 @@ void fatalError()
   }
 }
 
-String GetButtonInfo(Button* buttons, int buttonIndex)
+String GetButtonInfo(ButtonArray& buttons, int buttonIndex)
 {
-  String buttonInfo = String("Button[" + String(buttonIndex) + "] @ Pin " + String(buttons[buttonIndex].buttonState.pin) + " = " + String(buttons[buttonIndex].buttonState.active)); 
+  String buttonInfo = String("Button[" + String(buttonIndex) + "] @ Pin " + String(buttons.GetPin(buttonIndex)) + " = " + String(buttons.IsActive(buttonIndex))); 
 
   return buttonInfo;
 }
 
-void PrintAllButtonInfo(Button* buttons, int numButtons)
+void PrintAllButtonInfo(ButtonArray& buttons, int numButtons)
 {
   for (int buttonIndex = 0; buttonIndex < numButtons; buttonIndex++)
   {
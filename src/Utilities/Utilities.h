@@ -29,15 +29,16 @@
 
 #include "../Button.h"
 #include "../Sensor.h"
+#include "Crc8.h"
 
 void blinkOnce();
 void blinkOnceAt(int rateMs);
 void blinkFastNTimes(int numTimes);
 void fatalError();
 
-String GetButtonInfo(Button* buttons, int buttonIndex);
+String GetButtonInfo(ButtonArray& buttons, int buttonIndex);
 String GetSensorInfo(Sensor* sensors, int sensorIndex);
 
-void PrintAllButtonInfo(Button* buttons, int numButtons);
+void PrintAllButtonInfo(ButtonArray& buttons, int numButtons);
 
 #endif
@@ -0,0 +1,93 @@
+/*******************************************************************************
+  VerticalCounterDebouncer.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef VerticalCounterDebouncer_H
+#define VerticalCounterDebouncer_H
+
+#include <Arduino.h>
+
+#include "SharedConstants.h"
+
+// This class debounces a bank of buttons in parallel, one bit per button, using 2-bit vertical counters.
+// BitmapType may be uint8_t, uint16_t, uint32_t or uint64_t, to debounce 8, 16, 32 or 64 buttons per word.
+// Bit 0 of each counter is held in mCounterBit0, and bit 1 in mCounterBit1, so that all counters are updated with a few word operations.
+// A button's debounced state toggles only after it differs from the debounced state for VerticalCounterNumSamples consecutive samples,
+// taken VerticalCounterSamplePeriodMs apart, unless set otherwise; any sample that matches the debounced state resets the button's counter.
+// No per-button timestamps, or per-button branches, are needed.
+template <typename BitmapType>
+class VerticalCounterDebouncer
+{
+public:
+  VerticalCounterDebouncer()
+  {
+  }
+
+  // Samples the raw button states passed in, and returns the bitmap of buttons whose debounced state toggled.
+  // Presses of the buttons in eagerPressButtons (EagerPressDebounce) are accepted on every call, on their first edge;
+  // their releases are counted like any other change, so a re-press while the release is settling resets the counter.
+  // Other changes are counted only if the sample period has elapsed since the last sample.
+  BitmapType Update(BitmapType sampledButtons, unsigned long curTimeMs, BitmapType eagerPressButtons = 0)
+  {
+    BitmapType pressedButtons = sampledButtons & ~mDebouncedButtons & eagerPressButtons;
+    mDebouncedButtons |= pressedButtons;
+
+    if (curTimeMs - mLastSampleTimeMs < mSamplePeriodMs)
+    {
+      return pressedButtons;
+    }
+
+    mLastSampleTimeMs = curTimeMs;
+
+    // Count down the counters of changed buttons; reset the counters of unchanged buttons to 3.
+    BitmapType changedButtons = mDebouncedButtons ^ sampledButtons;
+    mCounterBit0 = ~(mCounterBit0 & changedButtons);
+    mCounterBit1 = mCounterBit0 ^ (mCounterBit1 & changedButtons);
+
+    // Toggle the buttons whose counter rolled over.
+    BitmapType toggledButtons = changedButtons & mCounterBit0 & mCounterBit1;
+    mDebouncedButtons ^= toggledButtons;
+
+    return toggledButtons | pressedButtons;
+  }
+
+  // Returns the bitmap of debounced button states.
+  BitmapType GetDebouncedButtons() { return mDebouncedButtons; }
+
+  // Sets the sample period from the debounce time passed in; the samples span the debounce time.
+  void SetDebounceDelayMs(uint8_t debounceDelayMs) { mSamplePeriodMs = debounceDelayMs / VerticalCounterNumSamples; }
+
+  // Returns true if no counter is counting down; then, sampling the debounced button states again changes nothing.
+  bool IsSettled() { return (BitmapType)(mCounterBit0 & mCounterBit1) == (BitmapType)~(BitmapType)0; }
+
+private:
+  BitmapType mDebouncedButtons = 0;
+  BitmapType mCounterBit0 = ~(BitmapType)0;
+  BitmapType mCounterBit1 = ~(BitmapType)0;
+  unsigned long mLastSampleTimeMs = 0;
+  uint8_t mSamplePeriodMs = VerticalCounterSamplePeriodMs;
+};
+
+#endif
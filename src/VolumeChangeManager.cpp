@@ -31,6 +31,7 @@
 #ifdef BUILD_RIGHT_HAND_MASTER
 
 #include "MIDIEventFlasher.h"
+#include "MidiBandwidthMeter.h"
 #include "VolumeChangeManager.h"
 #include "Utilities/Utilities.h"
 #include "SharedMacros.h"
@@ -44,6 +45,7 @@ const uint8_t MinMidiVolumeValueDifference = 2;
 const uint8_t ChannelVolumeControl = 0x07;
 
 extern StatusManager gStatusManager;
+extern MidiBandwidthMeter gMidiBandwidthMeter;
 extern ToneButtonManager gToneButtonManager; // TODO: Inject dependency.
 
 // This class is used by the Right Hand Arduino to keep track of the Tone Button states.
@@ -90,6 +92,16 @@ uint8_t VolumeChangeManager::GetLastSentMidiControlVolume(VolumeControlType volu
   return mLastSentMidiVolumeValue[volumeControlType];
 }
 
+// Sends the volume changes held back by UpdateMidiVolumeControl(), if the MIDI out is no longer busy.
+void VolumeChangeManager::UpdateDeferredMidiVolumeControl()
+{
+  if (mIsUpdateDeferred && !gMidiBandwidthMeter.IsBusy())
+  {
+    const bool IsForceUpdate = false;
+    UpdateMidiVolumeControl(IsForceUpdate);
+  }
+}
+
 void VolumeChangeManager::SendMidiVolumeChangeOnChannel(byte midiVolumeValue, byte channelZeroBased)
 {
 #ifdef SEND_MIDI
@@ -162,6 +174,19 @@ void VolumeChangeManager::UpdateMidiVolumeControl(bool forceUpdate)
     bool useBellowsVolume = gToneButtonManager.GetIsActive(ToneButtonRole::BellowsControlledVolumeEnabled);
 #endif // IGNORE_BELLOWS_VOLUME
 
+  // Hold back a volume sweep while the MIDI out is busy, so it does not delay the notes; the latest volume is sent once it is not.
+  if (!forceUpdate && (isBellowsVolumeChangedSignificantly || isMelodyVolumeChangedSignificantly || isBassChordVolumeChangedSignificantly) && gMidiBandwidthMeter.IsBusy())
+  {
+    if (!mIsUpdateDeferred)
+    {
+      gMidiBandwidthMeter.LogBackOff();
+      mIsUpdateDeferred = true;
+    }
+    return;
+  }
+
+  mIsUpdateDeferred = false;
+
   // Did Bellows or Melody volumes change significantly?
   if (isBellowsVolumeChangedSignificantly || isMelodyVolumeChangedSignificantly || forceUpdate)
   {
@@ -52,6 +52,9 @@ public:
   uint8_t GetLastSentMidiControlVolume(VolumeControlType volumeControlType);
   void UpdateMidiVolumeControl(bool forceUpdate);
 
+  // Sends the volume changes held back while the MIDI out was busy, once it is not. Called by loop().
+  void UpdateDeferredMidiVolumeControl();
+
 private:
   bool IsVolumeChangedSignificantly(VolumeControlType volumeControlType);
   void SendMidiVolumeChangeOnChannel(byte midiVolumeValue, byte channelZeroBased);
@@ -61,6 +64,7 @@ private:
   byte mCurMidiVolumeValue[VolumeControlType::LastVolumeControlType] = {UninitializedMidiVolume, UninitializedMidiVolume, UninitializedMidiVolume};
   byte mLastSentMidiVolumeValue[VolumeControlType::LastVolumeControlType] = {UninitializedMidiVolume, UninitializedMidiVolume, UninitializedMidiVolume};
   bool mIsAllVolumesInitialized = false;
+  bool mIsUpdateDeferred = false;
 };
 
 #endif
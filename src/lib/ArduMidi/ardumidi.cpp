@@ -19,6 +19,72 @@
 #include "ardumidi.h"
 #include "HardwareSerial.h"
 
+static bool running_status_enabled = false;
+static unsigned long running_status_refresh_ms = 0;
+static byte running_status = 0;		/* 0 when there is no running status */
+static unsigned long running_status_time_ms = 0;
+
+static midi_message_sink message_sink = NULL;
+
+static unsigned long messages_sent = 0;
+static unsigned long bytes_sent = 0;
+static unsigned long status_bytes_omitted = 0;
+static unsigned long total_bytes_sent = 0;
+
+static void midi_write(byte value)
+{
+	Serial.write(value);
+	bytes_sent++;
+	total_bytes_sent++;
+}
+
+static void midi_write_status(byte status)
+{
+	unsigned long now_ms = millis();
+	messages_sent++;
+	if (running_status_enabled && status == running_status && now_ms - running_status_time_ms < running_status_refresh_ms) {
+		status_bytes_omitted++;
+		return;
+	}
+	midi_write(status);
+	running_status = status;
+	running_status_time_ms = now_ms;
+}
+
+void midi_set_running_status(bool enabled, unsigned long refresh_ms)
+{
+	running_status_enabled = enabled;
+	running_status_refresh_ms = refresh_ms;
+	running_status = 0;
+}
+
+unsigned long midi_get_messages_sent()
+{
+	return messages_sent;
+}
+
+unsigned long midi_get_bytes_sent()
+{
+	return bytes_sent;
+}
+
+unsigned long midi_get_status_bytes_omitted()
+{
+	return status_bytes_omitted;
+}
+
+void midi_reset_byte_counts()
+{
+	messages_sent = 0;
+	bytes_sent = 0;
+	status_bytes_omitted = 0;
+}
+
+unsigned long midi_get_total_bytes_sent()
+{
+	return total_bytes_sent;
+}
+
 void midi_note_off(byte channel, byte key, byte velocity)
 {
 	midi_command(0x80, channel, key, velocity);
@@ -56,24 +122,57 @@ void midi_pitch_bend(byte channel, int value)
 
 void midi_command(byte command, byte channel, byte param1, byte param2)
 {
-	Serial.write(command | (channel & 0x0F));
-	Serial.write(param1 & 0x7F);
-	Serial.write(param2 & 0x7F);
+	if (message_sink != NULL) {
+		message_sink(command | (channel & 0x0F), param1 & 0x7F, param2 & 0x7F, 2);
+		return;
+	}
+	midi_write_message(command | (channel & 0x0F), param1 & 0x7F, param2 & 0x7F, 2);
 }
 
 void midi_command_short(byte command, byte channel, byte param1)
 {
-	Serial.write(command | (channel & 0x0F));
-	Serial.write(param1 & 0x7F);
+	if (message_sink != NULL) {
+		message_sink(command | (channel & 0x0F), param1 & 0x7F, 0, 1);
+		return;
+	}
+	midi_write_message(command | (channel & 0x0F), param1 & 0x7F, 0, 1);
+}
+
+void midi_set_message_sink(midi_message_sink sink)
+{
+	message_sink = sink;
+}
+
+void midi_write_message(byte status, byte param1, byte param2, byte num_params)
+{
+	midi_write_status(status);
+	midi_write(param1);
+	if (num_params > 1) {
+		midi_write(param2);
+	}
+}
+
+void midi_system_exclusive(const byte* data, int len)
+{
+	/* System exclusive cancels running status */
+	running_status = 0;
+	midi_write(0xF0);
+	for (int i = 0; i < len; i++) {
+		midi_write(data[i] & 0x7F);
+	}
+	midi_write(0xF7);
 }
 
 void midi_print(char* msg, int len)
 {
-	Serial.write(0xFF);
-	Serial.write(0x00);
-	Serial.write(0x00);
-	Serial.write(len);
+	running_status = 0;
+	midi_write(0xFF);
+	midi_write(0x00);
+	midi_write(0x00);
+	midi_write(len);
 	Serial.write(msg);
+	bytes_sent += len;
+	total_bytes_sent += len;
 }
 
 void midi_comment(char* msg)
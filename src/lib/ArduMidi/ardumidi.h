@@ -70,6 +70,27 @@ void midi_channel_pressure(byte channel, byte value);
 void midi_pitch_bend(byte channel, int value);
 void midi_command(byte command, byte channel, byte param1, byte param2);
 void midi_command_short(byte command, byte channel, byte param1);
+void midi_system_exclusive(const byte* data, int len);
+
+// Running status: a status byte equal to the last one sent is omitted, unless other
+// traffic was sent since, or refresh_ms has elapsed since it was last sent.
+void midi_set_running_status(bool enabled, unsigned long refresh_ms);
+
+// Message sink: if set, the channel messages are passed to it, instead of being written;
+// e.g. to queue them. The sink later writes them with midi_write_message().
+typedef void (*midi_message_sink)(byte status, byte param1, byte param2, byte num_params);
+void midi_set_message_sink(midi_message_sink sink);
+void midi_write_message(byte status, byte param1, byte param2, byte num_params);
+
+// Byte counts of the MIDI out traffic since the last reset; the channel messages sent,
+// all the bytes sent, and the status bytes omitted by running status.
+unsigned long midi_get_messages_sent();
+unsigned long midi_get_bytes_sent();
+unsigned long midi_get_status_bytes_omitted();
+void midi_reset_byte_counts();
+
+// All the bytes sent; not reset by midi_reset_byte_counts().
+unsigned long midi_get_total_bytes_sent();
 
 // MIDI out
 int midi_message_available();
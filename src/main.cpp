@@ -48,6 +48,29 @@
 #endif
 
 #include "ButtonsManager.h"
+#include "ButtonLayout.h"
+#ifdef ENABLE_PORT_REGISTER_SCAN
+  #include "ButtonPortScanner.h"
+#endif
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_TIMER_KEY_SCAN)
+  #include "TimerKeyScanner.h"
+#endif
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_PIN_CHANGE_CAPTURE)
+  #include "PinChangeCapture.h"
+#endif
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_ASYNC_I2C)
+  #include "TwiMaster.h"
+#endif
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_MIDI_TRANSMIT_QUEUE)
+  #include "MidiTransmitQueue.h"
+#endif
+#if defined(BUILD_RIGHT_HAND_MASTER)
+  #include "LeftHandLink.h"
+  #include "MidiBandwidthMeter.h"
+  #include "Utilities/I2CTelemetry.h"
+  #include "Utilities/MidiTelemetry.h"
+  #include "Utilities/SysExReportQueue.h"
+#endif
 #include "Utilities/Utilities.h"
 #include "SharedConstants.h"
 #include "SharedMacros.h"
@@ -56,57 +79,20 @@
   #include "Utilities/Diagnostics.h"
 #endif
 
-// Left Hand Button configuration. This is used by both Left and Right Hand Arduinos, hence outside of #ifdef.
-Button leftHandButtons[NumLeftHandButtons] = {
-  // Button {ButtonState buttonState, unsigned long lastToggleTimeMs} where
-  // ButtonState {active, pin, unused0, unused1, unused2}
-
-  // Note Indexes 00-11 (Bass)
-  {{false, 22, 0, 0, 0}, 0}, {{false, 23, 0, 0, 0}, 0}, {{false, 24, 0, 0, 0}, 0}, {{false, 25, 0, 0, 0}, 0},
-  {{false, 26, 0, 0, 0}, 0}, {{false, 27, 0, 0, 0}, 0}, {{false, 28, 0, 0, 0}, 0}, {{false, 29, 0, 0, 0}, 0},
-  {{false, 30, 0, 0, 0}, 0}, {{false, 31, 0, 0, 0}, 0}, {{false, 32, 0, 0, 0}, 0}, {{false, 33, 0, 0, 0}, 0},
+// Left Hand Button states. This is used by both Left and Right Hand Arduinos, hence outside of #ifdef.
+// The button pins are in LeftHandButtonPins, in ButtonLayout.h.
+ButtonArrayOf<NumLeftHandButtons> leftHandButtons(LeftHandButtonPins);
 
-  // Note Indexes 12-23 (Chords)
-  {{false, 34, 0, 0, 0}, 0}, {{false, 35, 0, 0, 0}, 0}, {{false, 36, 0, 0, 0}, 0}, {{false, 37, 0, 0, 0}, 0},
-  {{false, 38, 0, 0, 0}, 0}, {{false, 39, 0, 0, 0}, 0}, {{false, 40, 0, 0, 0}, 0}, {{false, 41, 0, 0, 0}, 0},
-  {{false, 42, 0, 0, 0}, 0}, {{false, 43, 0, 0, 0}, 0}, {{false, 44, 0, 0, 0}, 0}, {{false, 45, 0, 0, 0}, 0},
-
-  // Toggle Switches Indexes 24-37
-  {{false, 46, 0, 0, 0}, 0}, {{false, 47, 0, 0, 0}, 0}, {{false, 48, 0, 0, 0}, 0}, {{false, 49, 0, 0, 0}, 0},
-  {{false, 50, 0, 0, 0}, 0}, {{false, 51, 0, 0, 0}, 0}, {{false, 52, 0, 0, 0}, 0}, {{false, 2, 0, 0, 0}, 0},
-  {{false, 3, 0, 0, 0}, 0}, {{false, 4, 0, 0, 0}, 0}, {{false, 5, 0, 0, 0}, 0}, {{false, 6, 0, 0, 0}, 0},
-  {{false, 7, 0, 0, 0}, 0}, {{false, 8, 0, 0, 0}, 0}
-  };
+// The Button states are packed bitmaps, plus one byte per button; the previous Button structure took 8 bytes per button.
+static_assert(sizeof(leftHandButtons) < 3 * NumLeftHandButtons, "Left Hand Button states take more than 3 bytes per button.");
 
 #if defined(BUILD_RIGHT_HAND_MASTER)
 
-// Right Hand Button configuration. Only used when built for BUILD_RIGHT_HAND_MASTER.
-Button rightHandButtons[NumRightHandButtons] = {
-  // Button {ButtonState buttonState, unsigned long lastToggleTimeMs} where
-  // ButtonState {active, pin, unused0, unused1, unused2}
-
-  // Notes 01-12
-  {{false, 22, 0, 0, 0}, 0}, {{false, 23, 0, 0, 0}, 0}, {{false, 24, 0, 0, 0}, 0}, {{false, 25, 0, 0, 0}, 0},
-  {{false, 26, 0, 0, 0}, 0}, {{false, 27, 0, 0, 0}, 0}, {{false, 28, 0, 0, 0}, 0}, {{false, 29, 0, 0, 0}, 0},
-  {{false, 30, 0, 0, 0}, 0}, {{false, 31, 0, 0, 0}, 0}, {{false, 32, 0, 0, 0}, 0}, {{false, 33, 0, 0, 0}, 0},
-
-  // Notes 13-24
-  {{false, 34, 0, 0, 0}, 0}, {{false, 35, 0, 0, 0}, 0}, {{false, 36, 0, 0, 0}, 0}, {{false, 37, 0, 0, 0}, 0},
-  {{false, 38, 0, 0, 0}, 0}, {{false, 39, 0, 0, 0}, 0}, {{false, 40, 0, 0, 0}, 0}, {{false, 41, 0, 0, 0}, 0},
-  {{false, 42, 0, 0, 0}, 0}, {{false, 43, 0, 0, 0}, 0}, {{false, 44, 0, 0, 0}, 0}, {{false, 45, 0, 0, 0}, 0},
+// Right Hand Button states. Only used when built for BUILD_RIGHT_HAND_MASTER.
+// The button pins are in RightHandButtonPins, in ButtonLayout.h.
+ButtonArrayOf<NumRightHandButtons> rightHandButtons(RightHandButtonPins);
 
-  // Notes 25-30
-  {{false, 46, 0, 0, 0}, 0}, {{false, 47, 0, 0, 0}, 0}, {{false, 48, 0, 0, 0}, 0}, {{false, 49, 0, 0, 0}, 0},
-  {{false, 50, 0, 0, 0}, 0}, {{false, 51, 0, 0, 0}, 0}, {{false, 52, 0, 0, 0}, 0}, {{false, 53, 0, 0, 0}, 0},
-
-  // Notes 31-41
-  {{false, 2, 0, 0, 0}, 0}, {{false, 3, 0, 0, 0}, 0}, {{false, 4, 0, 0, 0}, 0}, {{false, 5, 0, 0, 0}, 0},
-  {{false, 6, 0, 0, 0}, 0}, {{false, 7, 0, 0, 0}, 0}, {{false, 8, 0, 0, 0}, 0}, {{false, 9, 0, 0, 0}, 0},
-  {{false, 10, 0, 0, 0}, 0},
-
-  // Custom Buttons; Decrement and Increment Program Number.
-  {{false, 11, 0, 0, 0}, 0}, {{false, 12, 0, 0, 0}, 0}
-  };
+static_assert(sizeof(rightHandButtons) < 3 * NumRightHandButtons, "Right Hand Button states take more than 3 bytes per button.");
 
 // Right Hand Sensor configuration.
 Sensor rightHandSensors[NumRightHandSensors] = {
@@ -121,7 +107,41 @@ Sensor rightHandSensors[NumRightHandSensors] = {
   {0xFFFF, A4}, // Bass/Chord Volume
   };
 
-ButtonsManager* pButtonsManager = new ButtonsManager(leftHandButtons, rightHandButtons, NULL, rightHandSensors);
+ButtonsManager* pButtonsManager = new ButtonsManager(&leftHandButtons, &rightHandButtons, NULL, rightHandSensors);
+
+#ifdef ENABLE_PORT_REGISTER_SCAN
+#if defined(ENABLE_TIMER_KEY_SCAN) || defined(ENABLE_PIN_CHANGE_CAPTURE)
+// Right Hand Button banks; Keys, and Custom Buttons. The Keys are read apart from the Custom Buttons.
+ButtonBankScanner<RightHandButtonLayout, RightHandKeys> melodyButtonPortScanner(rightHandButtons);
+ButtonBankScanner<RightHandButtonLayout, RightHandCustomButtons> programChangeButtonPortScanner(rightHandButtons);
+#else
+// All Right Hand Buttons, read in one pass; rightHandInputZones gives the handler of each bank.
+ButtonLayoutScanner<RightHandButtonLayout> rightHandButtonPortScanner(rightHandButtons);
+#endif
+#endif // ENABLE_PORT_REGISTER_SCAN
+
+#ifdef ENABLE_TIMER_KEY_SCAN
+// Samples the Keys from the Timer1 interrupt; melodyButtonPortScanner is then owned by the interrupt.
+TimerKeyScanner gTimerKeyScanner(melodyButtonPortScanner);
+#endif // ENABLE_TIMER_KEY_SCAN
+
+#ifdef ENABLE_PIN_CHANGE_CAPTURE
+// Captures the edges of the Keys on Port B between scans.
+ButtonBankPinChangeCapture<RightHandButtonLayout, RightHandKeys> melodyButtonPinChangeCapture;
+#endif // ENABLE_PIN_CHANGE_CAPTURE
+
+#ifdef ENABLE_ASYNC_I2C
+// Fetches the LH button states without blocking loop(); started by RightHandSetupManager.
+TwiMaster gTwiMaster;
+#endif // ENABLE_ASYNC_I2C
+
+// The link to the LH Arduino; I2C, or UART if ENABLE_UART_LINK is defined.
+LeftHandLink gLeftHandLink;
+
+#ifdef ENABLE_MIDI_TRANSMIT_QUEUE
+// Queues the MIDI messages, so that loop() never waits for the MIDI out; started by RightHandSetupManager, and drained by loop().
+MidiTransmitQueue gMidiTransmitQueue;
+#endif // ENABLE_MIDI_TRANSMIT_QUEUE
 
 // RightHandLoopHandler loopHandler;
 RightHandSetupManager setupManager;
@@ -133,9 +153,40 @@ ProgramChangeManager gProgramChangeManager;
 MIDIEventFlasher gMIDIEventFlasher;
 StatusManager gStatusManager;
 
+// LH fetch statistics; reported by ToneButtonRole::SendTelemetry.
+I2CTelemetry gI2CTelemetry;
+
+// MIDI out statistics; reported by ToneButtonRole::SendTelemetry.
+MidiTelemetry gMidiTelemetry;
+
+// The telemetry SysEx reports; sent by loop(), one per pass, once the MIDI out has room for them.
+SysExReportQueue gSysExReportQueue;
+
+// MIDI out utilization; VolumeChangeManager backs off while it is busy.
+MidiBandwidthMeter gMidiBandwidthMeter;
+
+// Right Hand input zones, in button index order; {first button index, last button index, handler, debounce policy}.
+const InputZone rightHandInputZones[] = {
+  {FirstRightHandKeyIndex, FirstRightHandKeyIndex + NumRightHandKeys - 1, &melodyButtonChangedHandler, BankDebouncePolicies[RightHandKeys]},
+  {FirstRightHandCustomButtonIndex, FirstRightHandCustomButtonIndex + NumRightHandCustomButtons - 1, &programChangeButtonChangedHandler, BankDebouncePolicies[RightHandCustomButtons]},
+  };
+
 #elif defined(BUILD_LEFT_HAND_SLAVE)
-ButtonsManager* pButtonsManager = new ButtonsManager(leftHandButtons, NULL, NULL, NULL);
+ButtonsManager* pButtonsManager = new ButtonsManager(&leftHandButtons, NULL, NULL, NULL);
+
+#ifdef ENABLE_PORT_REGISTER_SCAN
+// All Left Hand Buttons, read in one pass; leftHandInputZones gives the handler of each bank.
+ButtonLayoutScanner<LeftHandButtonLayout> leftHandButtonPortScanner(leftHandButtons);
+#endif // ENABLE_PORT_REGISTER_SCAN
+
 LeftHandButtonChangedHandler leftHandButtonChangedHandler;
+
+// Left Hand input zones; Bass, Chords, and Tone Switches. The LH Arduino debounces only if ENABLE_LH_SLAVE_DEBOUNCE is defined; see loop().
+const InputZone leftHandInputZones[] = {
+  {FirstBassButtonIndex, FirstBassButtonIndex + NumBassButtons - 1, &leftHandButtonChangedHandler, BankDebouncePolicies[LeftHandBassButtons]},
+  {FirstChordButtonIndex, FirstChordButtonIndex + NumChordButtons - 1, &leftHandButtonChangedHandler, BankDebouncePolicies[LeftHandChordButtons]},
+  {FirstToneSwitchIndex, FirstToneSwitchIndex + NumToneSwitches - 1, &leftHandButtonChangedHandler, BankDebouncePolicies[LeftHandToneSwitches]},
+  };
 // LeftHandSensorChangedHandler sensorChangedHandler;
 LeftHandSetupManager setupManager;
 #endif
@@ -150,8 +201,21 @@ void setup()
   // Setup serial port and pin states.
   setupManager.Setup();
 
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_TIMER_KEY_SCAN)
+  // Start sampling the Keys once their pins are set up.
+  gTimerKeyScanner.Start();
+#endif
+
+#if defined(BUILD_RIGHT_HAND_MASTER) && defined(ENABLE_PIN_CHANGE_CAPTURE)
+  melodyButtonPinChangeCapture.Start();
+#endif
+
   DBG_PRINT_LN("MIDIAccordion::Setup() - Setup done.");
 
+#if defined(BUILD_RIGHT_HAND_MASTER)
+  DBG_PRINT_LN("MIDIAccordion::Setup() - Button state SRAM: RH = " + String(sizeof(rightHandButtons)) + " bytes, LH = " + String(sizeof(leftHandButtons)) + " bytes.");
+#endif
+
   //DBG_PRINT_LN(PrintAllButtonInfo(leftHandButtons, NumLeftHandButtons));
 }
 
@@ -161,13 +225,36 @@ void loop()
 #if defined(BUILD_RIGHT_HAND_MASTER)
   // LOG_LOOP_TIME();
 
+  // All inputs read in this pass share the clock of the ScanFrame; the RH button changes are handled by DispatchButtonEvents(), the others by EndScanFrame().
+  pButtonsManager->BeginScanFrame();
+
   // Read buttons attached to Right Hand Arduino.
+  // unsigned long scanStartTimeMicroseconds = micros();
 
-  // Keys
-  pButtonsManager->ReadButtons(rightHandButtons, 0, 40, melodyButtonChangedHandler, true);
+#if defined(ENABLE_TIMER_KEY_SCAN)
+  // Keys; sampled by the timer interrupt.
+  pButtonsManager->DispatchButtonEvents(gTimerKeyScanner, melodyButtonChangedHandler);
 
   // Custom Buttons
-  pButtonsManager->ReadButtons(rightHandButtons, 41, 42, programChangeButtonChangedHandler, true);
+  pButtonsManager->ReadButtons(programChangeButtonPortScanner, programChangeButtonChangedHandler, true);
+#elif defined(ENABLE_PIN_CHANGE_CAPTURE)
+  // Keys; with the edges captured since the last scan.
+  pButtonsManager->ReadButtons(melodyButtonPortScanner, melodyButtonPinChangeCapture, melodyButtonChangedHandler, true);
+
+  // Custom Buttons
+  pButtonsManager->ReadButtons(programChangeButtonPortScanner, programChangeButtonChangedHandler, true);
+#elif defined(ENABLE_PORT_REGISTER_SCAN)
+  // Keys, and Custom Buttons
+  pButtonsManager->ReadButtons(rightHandButtonPortScanner, rightHandInputZones, COUNT_ENTRIES(rightHandInputZones), true);
+#else
+  // Keys, and Custom Buttons
+  pButtonsManager->ReadButtons(rightHandButtons, rightHandInputZones, COUNT_ENTRIES(rightHandInputZones), true);
+#endif // ENABLE_PORT_REGISTER_SCAN
+
+  // LOG_SCAN_TIME(scanStartTimeMicroseconds);
+
+  // Send the RH button changes now; the sensor reads, about 0.5 ms, and a blocking LH fetch, would otherwise delay their MIDI messages.
+  pButtonsManager->DispatchButtonEvents();
   
   #ifndef DISABLE_SENSOR_READS
   pButtonsManager->ReadSensors(rightHandSensors, NumRightHandSensors, sensorChangedHandler);
@@ -179,11 +266,53 @@ void loop()
   pButtonsManager->FetchLeftHandArduinoButtons();
   #endif // DISABLE_I2C
 
+  pButtonsManager->EndScanFrame();
+
+#ifdef ENABLE_MIDI_TRANSMIT_QUEUE
+  // Send the MIDI messages that did not fit in the Serial TX buffer when queued.
+  gMidiTransmitQueue.Update();
+#endif
+
+  // Send a telemetry report, if one is waiting, and fits.
+  gSysExReportQueue.Update();
+
+  gMidiBandwidthMeter.Update(millis());
+
+  // Send the latest volume, if it was held back while the MIDI out was busy.
+  gVolumeChangeManager.UpdateDeferredMidiVolumeControl();
+
   gStatusManager.UpdateStatusIndicator();
 #elif defined(BUILD_LEFT_HAND_SLAVE)
+  // The commands of the RH Arduino are handled between scans; a scan starts once the scan interval set by the RH Arduino elapsed.
+  LeftHandSetupManager::HandleMasterCommands();
+  if (!LeftHandSetupManager::BeginScan())
+  {
+    return;
+  }
+
   // DBG_PRINT_LN("Loop() BUILD_LEFT_HAND_SLAVE - Calling pButtonsManager->ReadButtons().");
-  pButtonsManager->ReadButtons(leftHandButtons, 0, NumLeftHandButtons-1, leftHandButtonChangedHandler, false);
+  pButtonsManager->BeginScanFrame();
+
+  // Otherwise, the RH Arduino debounces the LH buttons.
+#ifdef ENABLE_LH_SLAVE_DEBOUNCE
+  const bool IsDebounce = true;
+#else
+  const bool IsDebounce = false;
+#endif // ENABLE_LH_SLAVE_DEBOUNCE
+
+#ifdef ENABLE_PORT_REGISTER_SCAN
+  pButtonsManager->ReadButtons(leftHandButtonPortScanner, leftHandInputZones, COUNT_ENTRIES(leftHandInputZones), IsDebounce);
+#else
+  pButtonsManager->ReadButtons(leftHandButtons, leftHandInputZones, COUNT_ENTRIES(leftHandInputZones), IsDebounce);
+#endif // ENABLE_PORT_REGISTER_SCAN
   // Uncomment if using sensors in the LH Arduino. pButtonsManager->ReadSensors(leftHandSensors, NumLeftHandSensors, sensorChangedHandler);
+
+  pButtonsManager->EndScanFrame();
+  LeftHandSetupManager::EndScan(pButtonsManager->GetScanFrame().timeMs);
+
+#ifdef ENABLE_UART_LINK
+  LeftHandSetupManager::UpdateUartLink(pButtonsManager->GetScanFrame().timeMs);
+#endif
 #endif
 }
 
@@ -0,0 +1,282 @@
+/*******************************************************************************
+  Arduino.h
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+#ifndef NativeArduino_H
+#define NativeArduino_H
+
+// This file stands in for the Arduino core, and the Arduino Mega pin map, in the native test environment; see platformio.ini.
+// It has only what the sketch uses. The port input registers, PINA to PINL, are bytes that the tests set, and whose reads are counted;
+// digitalRead() reads them through the pin tables, as the AVR core does. HardwareSerial records the bytes written, and serves the bytes queued to be read;
+// millis() and micros() return a clock that the tests set.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+#define B10000000 0x80
+#define B11110000 0xF0
+#define B00001111 0x0F
+
+#define lowByte(w) ((uint8_t)((w) & 0xFF))
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define bit(b) (1UL << (b))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+
+inline uint16_t makeWord(uint16_t w) { return w; }
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+#define noInterrupts()
+#define interrupts()
+
+static const uint8_t SDA = 20;
+static const uint8_t SCL = 21;
+
+enum { A0 = 54, A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15 };
+
+// --- Clock
+
+inline unsigned long& NativeMillis()
+{
+  static unsigned long sMillis = 0;
+  return sMillis;
+}
+
+inline unsigned long& NativeMicros()
+{
+  static unsigned long sMicros = 0;
+  return sMicros;
+}
+
+inline unsigned long millis() { return NativeMillis(); }
+inline unsigned long micros() { return NativeMicros(); }
+inline void delay(unsigned long ms) { NativeMillis() += ms; NativeMicros() += ms * 1000; }
+inline void delayMicroseconds(unsigned int us) { NativeMicros() += us; }
+
+// --- Pins
+
+// The input registers of the ATmega2560 ports A to L; there is no Port I. The tests set them; a pulled up, released, button reads 1.
+// The sketch reads them with PINA to PINL, as on the AVR.
+inline uint8_t* NativePortInputRegisters()
+{
+  static uint8_t sPortInputRegisters[11] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  return sPortInputRegisters;
+}
+
+// The number of port input register reads, by PINx, or digitalRead(); the tests compare the reads of each scan path.
+inline unsigned long& NativeNumPortInputRegisterReads()
+{
+  static unsigned long sNumPortInputRegisterReads = 0;
+  return sNumPortInputRegisterReads;
+}
+
+inline uint8_t NativeReadPortInputRegister(uint8_t port)
+{
+  NativeNumPortInputRegisterReads()++;
+  volatile uint8_t* portInputRegisters = NativePortInputRegisters();
+  return portInputRegisters[port];
+}
+
+#define PINA NativeReadPortInputRegister(0)
+#define PINB NativeReadPortInputRegister(1)
+#define PINC NativeReadPortInputRegister(2)
+#define PIND NativeReadPortInputRegister(3)
+#define PINE NativeReadPortInputRegister(4)
+#define PINF NativeReadPortInputRegister(5)
+#define PING NativeReadPortInputRegister(6)
+#define PINH NativeReadPortInputRegister(7)
+#define PINJ NativeReadPortInputRegister(8)
+#define PINK NativeReadPortInputRegister(9)
+#define PINL NativeReadPortInputRegister(10)
+
+// The Arduino Mega pin map, from pins_arduino.h of the AVR core; the port index (PINA is 0), bit mask, and PWM timer, of each pin.
+static const uint8_t NativeNumPins = 70;
+static const uint8_t NativeNotOnTimer = 0;
+
+static const uint8_t NativePinToPort[NativeNumPins] = {
+  4, 4, 4, 4, 6, 4, 7, 7, 7, 7,
+  1, 1, 1, 1, 8, 8, 7, 7, 3, 3,
+  3, 3, 0, 0, 0, 0, 0, 0, 0, 0,
+  2, 2, 2, 2, 2, 2, 2, 2, 3, 6,
+  6, 6, 10, 10, 10, 10, 10, 10, 10, 10,
+  1, 1, 1, 1, 5, 5, 5, 5, 5, 5,
+  5, 5, 9, 9, 9, 9, 9, 9, 9, 9
+  };
+
+static const uint8_t NativePinToBitMask[NativeNumPins] = {
+  0x01, 0x02, 0x10, 0x20, 0x20, 0x08, 0x08, 0x10, 0x20, 0x40,
+  0x10, 0x20, 0x40, 0x80, 0x02, 0x01, 0x02, 0x01, 0x08, 0x04,
+  0x02, 0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+  0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x80, 0x04,
+  0x02, 0x01, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+  0x08, 0x04, 0x02, 0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20,
+  0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+  };
+
+// Pins 2 to 13, and 44 to 46, are PWM pins.
+static const uint8_t NativePinToTimer[NativeNumPins] = {
+  0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 1, 1, 1, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+  };
+
+// The PWM output of each timer; turned off by digitalRead(), as the AVR core does.
+inline uint8_t* NativeTimerOutputs()
+{
+  static uint8_t sTimerOutputs[2] = {0, 0};
+  return sTimerOutputs;
+}
+
+// The output levels set by digitalWrite(), and the values returned by analogRead(), by pin.
+inline uint8_t* NativePinOutputLevels()
+{
+  static uint8_t sPinOutputLevels[NativeNumPins];
+  return sPinOutputLevels;
+}
+
+inline int* NativeAnalogValues()
+{
+  static int sAnalogValues[NativeNumPins];
+  return sAnalogValues;
+}
+
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+
+// As digitalRead() of the AVR core; the pin's timer, port, and bit mask, are looked up, any PWM output of the pin is turned off,
+// then the port input register is read. The volatile reads stand in for the AVR's program memory, and I/O register, reads.
+inline int digitalRead(uint8_t pin)
+{
+  volatile const uint8_t* pinToTimer = NativePinToTimer;
+  volatile const uint8_t* pinToBitMask = NativePinToBitMask;
+  volatile const uint8_t* pinToPort = NativePinToPort;
+  uint8_t timer = pinToTimer[pin];
+  uint8_t bitMask = pinToBitMask[pin];
+  uint8_t port = pinToPort[pin];
+
+  if (timer != NativeNotOnTimer)
+  {
+    NativeTimerOutputs()[timer] = 0;
+  }
+
+  return (NativeReadPortInputRegister(port) & bitMask) ? HIGH : LOW;
+}
+
+inline void digitalWrite(uint8_t pin, uint8_t value) { NativePinOutputLevels()[pin] = value; }
+inline int analogRead(uint8_t pin) { return NativeAnalogValues()[pin]; }
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// --- String
+
+class String : public std::string
+{
+public:
+  String() {}
+  String(const char* text) : std::string(text) {}
+  String(const std::string& text) : std::string(text) {}
+  String(char value) : std::string(1, value) {}
+  String(int value, int base = DEC) : String((long)value, base) {}
+  String(unsigned int value, int base = DEC) : String((unsigned long)value, base) {}
+  String(long value, int base = DEC) : std::string(value < 0 ? "-" + String((unsigned long)-value, base) : String((unsigned long)value, base)) {}
+  String(unsigned long value, int base = DEC)
+  {
+    do
+    {
+      insert(begin(), "0123456789ABCDEF"[value % base]);
+      value /= base;
+    } while (value != 0);
+  }
+  String(double value, int decimalPlaces = 2) : std::string(std::to_string(value)) {}
+};
+
+inline String operator+(const String& left, const String& right) { return String((const std::string&)left + (const std::string&)right); }
+inline String operator+(const String& left, const char* right) { return left + String(right); }
+inline String operator+(const char* left, const String& right) { return String(left) + right; }
+
+// --- Serial
+
+class HardwareSerial
+{
+public:
+  void begin(unsigned long baudRate) {}
+  void end() {}
+  void flush() {}
+  operator bool() { return true; }
+
+  size_t write(uint8_t value) { mWrittenBytes.push_back(value); return 1; }
+  size_t write(const uint8_t* values, size_t numValues) { for (size_t i = 0; i < numValues; i++) { write(values[i]); } return numValues; }
+  size_t write(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+  int availableForWrite() { return mNumBytesAvailableForWrite; }
+
+  size_t print(const String& text) { return write(text.c_str()); }
+  size_t println(const String& text = String()) { return print(text) + write("\r\n"); }
+
+  int available() { return (int)(mBytesToRead.size() - mNumBytesRead); }
+  int peek() { return available() > 0 ? mBytesToRead[mNumBytesRead] : -1; }
+  int read() { return available() > 0 ? mBytesToRead[mNumBytesRead++] : -1; }
+
+  // Test access; the bytes written, the room in the TX buffer, and the bytes to be read.
+  std::vector<uint8_t> mWrittenBytes;
+  int mNumBytesAvailableForWrite = 63;
+  std::vector<uint8_t> mBytesToRead;
+  size_t mNumBytesRead = 0;
+
+  void Reset() { mWrittenBytes.clear(); mNumBytesAvailableForWrite = 63; mBytesToRead.clear(); mNumBytesRead = 0; }
+};
+
+inline HardwareSerial Serial;
+inline HardwareSerial Serial1;
+inline HardwareSerial Serial2;
+inline HardwareSerial Serial3;
+
+#endif
@@ -0,0 +1,197 @@
+/*******************************************************************************
+  test_main.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+// Native footprint test of the button states; run with: pio test -e native -f test_button_footprint
+// Compares ButtonArray against the Button structure array it replaced; its SRAM, and the compare of a bank of buttons
+// against the pressed buttons read by a scan. The host times are only a relative measure.
+
+#include <chrono>
+#include <stdio.h>
+#include <unity.h>
+
+#include "Button.h"
+#include "ButtonLayout.h"
+
+// The Button structure that ButtonArray replaced; a 32-bit bit field, mostly unused, and a 32-bit toggle time on the AVR.
+typedef struct
+{
+  uint32_t active  :  1;
+  uint32_t pin     :  7;
+  uint32_t unused0 : 10;
+  uint32_t unused1 :  7;
+  uint32_t unused2 :  7;
+} LegacyButtonState;
+
+typedef struct
+{
+  LegacyButtonState buttonState;
+  unsigned long lastToggleTimeMs;
+} LegacyButton;
+
+// The size of LegacyButton on the AVR, where unsigned long is 32 bits.
+static const unsigned long AvrLegacyButtonNumBytes = 8;
+
+// The number of compares timed, per repetition; the fastest repetition is reported.
+static const unsigned long NumTimedCompares = 200000;
+static const uint8_t NumTimedRepetitions = 5;
+
+// The pressed buttons read by successive scans; mostly unchanged, as while a chord is held, with a change every 16 scans.
+static const uint8_t NumPressedButtonScans = 64;
+static uint64_t sPressedButtonScans[NumPressedButtonScans];
+
+static ButtonArrayOf<NumRightHandButtons> sButtons(RightHandButtonPins);
+static LegacyButton sLegacyButtons[NumRightHandButtons];
+
+// Keeps the compiler from optimizing away the value passed in.
+template <typename T> static inline void KeepValue(const T& value)
+{
+  asm volatile("" : : "g"(value) : "memory");
+}
+
+void setUp()
+{
+  const uint64_t HeldChord = ButtonArray::GetButtonMask(0) | ButtonArray::GetButtonMask(4) | ButtonArray::GetButtonMask(7);
+  for (uint8_t i = 0; i < NumPressedButtonScans; i++)
+  {
+    sPressedButtonScans[i] = (i % 16) == 15 ? HeldChord | ButtonArray::GetButtonMask(20 + i / 16) : HeldChord;
+  }
+
+  for (uint8_t i = 0; i < NumRightHandButtons; i++)
+  {
+    bool isActive = (HeldChord & ButtonArray::GetButtonMask(i)) != 0;
+    sButtons.SetActive(i, isActive);
+    sLegacyButtons[i].buttonState.active = isActive;
+    sLegacyButtons[i].buttonState.pin = RightHandButtonPins[i];
+    sLegacyButtons[i].lastToggleTimeMs = 0;
+  }
+}
+
+void tearDown()
+{
+}
+
+// Returns the bitmap of changed buttons; one compare of the bank's active bitmap, as ButtonsManager::UpdateZoneButtons() does.
+static uint64_t CompareBank(uint64_t pressedButtons)
+{
+  return pressedButtons ^ sButtons.GetActiveButtons();
+}
+
+// Returns the bitmap of changed buttons; a compare per Button, as ButtonsManager::ReadButtons() did with the Button structures.
+static uint64_t CompareButtons(uint64_t pressedButtons)
+{
+  uint64_t changedButtons = 0;
+  for (uint8_t i = 0; i < NumRightHandButtons; i++)
+  {
+    bool isPressed = (pressedButtons >> i) & 1;
+    if (sLegacyButtons[i].buttonState.active != isPressed)
+    {
+      changedButtons |= (uint64_t)1 << i;
+    }
+  }
+
+  return changedButtons;
+}
+
+// Returns the time of a compare, in ns; the fastest of the repetitions.
+template <uint64_t (*Compare)(uint64_t)>
+static double TimeCompare()
+{
+  double minCompareTimeNs = 0;
+  for (uint8_t repetition = 0; repetition < NumTimedRepetitions; repetition++)
+  {
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < NumTimedCompares; i++)
+    {
+      uint64_t pressedButtons = sPressedButtonScans[i % NumPressedButtonScans];
+      KeepValue(pressedButtons);
+      KeepValue(Compare(pressedButtons));
+    }
+    std::chrono::duration<double, std::nano> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+    double compareTimeNs = elapsedTime.count() / NumTimedCompares;
+    if (repetition == 0 || compareTimeNs < minCompareTimeNs)
+    {
+      minCompareTimeNs = compareTimeNs;
+    }
+  }
+
+  return minCompareTimeNs;
+}
+
+// The button states of each Arduino take less SRAM than the Button structures did; 8 bytes per button on the AVR.
+void test_button_state_footprint()
+{
+  ButtonArrayOf<NumRightHandButtons> rightHandButtons(RightHandButtonPins);
+  ButtonArrayOf<NumLeftHandButtons> leftHandButtons(LeftHandButtonPins);
+
+  char message[160];
+  snprintf(message, sizeof(message), "RH %u buttons: ButtonArrayOf %zu bytes (host), Button structures %lu bytes (AVR), %zu bytes (host)",
+    NumRightHandButtons, sizeof(rightHandButtons), NumRightHandButtons * AvrLegacyButtonNumBytes, NumRightHandButtons * sizeof(LegacyButton));
+  TEST_MESSAGE(message);
+  snprintf(message, sizeof(message), "LH %u buttons: ButtonArrayOf %zu bytes (host), Button structures %lu bytes (AVR), %zu bytes (host)",
+    NumLeftHandButtons, sizeof(leftHandButtons), NumLeftHandButtons * AvrLegacyButtonNumBytes, NumLeftHandButtons * sizeof(LegacyButton));
+  TEST_MESSAGE(message);
+
+  // The host's 64-bit pointers make ButtonArray larger than on the AVR; it is still smaller than the AVR's Button structures.
+  TEST_ASSERT_LESS_THAN(NumRightHandButtons * AvrLegacyButtonNumBytes, sizeof(rightHandButtons));
+  TEST_ASSERT_LESS_THAN(NumLeftHandButtons * AvrLegacyButtonNumBytes, sizeof(leftHandButtons));
+
+  // The per-button storage is the settle time byte, plus the alignment padding.
+  TEST_ASSERT_LESS_THAN(NumRightHandButtons + 8, sizeof(ButtonArrayOf<NumRightHandButtons>) - sizeof(ButtonArray));
+}
+
+// Both compares find the same changed buttons.
+void test_bank_compare_matches_button_compare()
+{
+  for (uint8_t i = 0; i < NumPressedButtonScans; i++)
+  {
+    uint64_t changedButtons = CompareBank(sPressedButtonScans[i]);
+    TEST_ASSERT_TRUE(changedButtons == CompareButtons(sPressedButtonScans[i]));
+    TEST_ASSERT_EQUAL((i % 16) == 15 ? 1 : 0, __builtin_popcountll(changedButtons));
+  }
+}
+
+void test_bank_compare_time()
+{
+  double bankCompareTimeNs = TimeCompare<CompareBank>();
+  double buttonCompareTimeNs = TimeCompare<CompareButtons>();
+
+  char message[160];
+  snprintf(message, sizeof(message), "Compare of %u buttons: per Button structure %.2f ns, whole bank %.2f ns (host); %.1fx",
+    NumRightHandButtons, buttonCompareTimeNs, bankCompareTimeNs, buttonCompareTimeNs / bankCompareTimeNs);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_LESS_THAN(buttonCompareTimeNs, bankCompareTimeNs);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_button_state_footprint);
+  RUN_TEST(test_bank_compare_matches_button_compare);
+  RUN_TEST(test_bank_compare_time);
+  return UNITY_END();
+}
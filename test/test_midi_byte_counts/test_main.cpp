@@ -0,0 +1,175 @@
+/*******************************************************************************
+  test_main.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+// Native byte count benchmark of the MIDI out encoder; run with: pio test -e native -f test_midi_byte_counts
+// Replays a hand-written note trace through ArduMidi, with, and without, running status (ENABLE_MIDI_RUNNING_STATUS),
+// and with releases sent as Note Off, or as Note On with velocity 0 (ENABLE_NOTE_OFF_AS_VELOCITY_ZERO), by NoteButtonChangedHandler.
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "SharedConstants.h"
+#include "ButtonChangedHandlers/NoteButtonChangedHandler.h"
+#include "lib/ArduMidi/ardumidi.h"
+
+// A button press, or release, as NoteButtonChangedHandler sends it.
+struct NoteTraceEvent
+{
+  unsigned long timeMs;
+  byte channel;
+  byte noteNum;
+  bool isPressed;
+};
+
+// A hand-written bass, and chord, accompaniment, not captured from the instrument; a bass note on channel 1, then a 3 note chord on channel 2, twice,
+// then a chord held longer than MidiRunningStatusRefreshMs.
+static const NoteTraceEvent NoteTrace[] =
+{
+  {0, 1, 36, true},
+  {120, 1, 36, false},
+  {150, 2, 48, true}, {150, 2, 52, true}, {150, 2, 55, true},
+  {270, 2, 48, false}, {270, 2, 52, false}, {270, 2, 55, false},
+  {300, 1, 43, true},
+  {420, 1, 43, false},
+  {450, 2, 48, true}, {450, 2, 52, true}, {450, 2, 55, true},
+  {570, 2, 48, false}, {570, 2, 52, false}, {570, 2, 55, false},
+  {1000, 2, 48, true}, {1000, 2, 52, true}, {1000, 2, 55, true},
+  {1400, 2, 48, false}, {1400, 2, 52, false}, {1400, 2, 55, false},
+};
+static const unsigned long NumNoteTraceEvents = sizeof(NoteTrace) / sizeof(NoteTrace[0]);
+
+// Bits per byte on the MIDI wire; start, 8 data, and stop, bits.
+static const unsigned long NumBitsPerMidiByte = 10;
+
+void setUp()
+{
+  NativeMillis() = 0;
+  Serial.Reset();
+  midi_set_message_sink(NULL);
+  midi_set_running_status(false, 0);
+  midi_reset_byte_counts();
+}
+
+void tearDown()
+{
+}
+
+static void ReplayNoteTrace(bool isRunningStatusEnabled, bool isNoteOffAsVelocityZero)
+{
+  midi_set_running_status(isRunningStatusEnabled, MidiRunningStatusRefreshMs);
+  for (unsigned long i = 0; i < NumNoteTraceEvents; i++)
+  {
+    const NoteTraceEvent& event = NoteTrace[i];
+    NativeMillis() = event.timeMs;
+    if (event.isPressed)
+    {
+      midi_note_on(event.channel, event.noteNum, DefaultVelocity);
+    }
+    else
+    {
+      NoteButtonChangedHandler::SendMidiNoteRelease(event.noteNum, event.channel, isNoteOffAsVelocityZero);
+    }
+  }
+
+  unsigned long numBytes = midi_get_bytes_sent();
+  char message[160];
+  snprintf(message, sizeof(message), "running status %s, note off as velocity 0 %s: %lu messages, %lu bytes, %lu status bytes omitted, %lu us",
+    isRunningStatusEnabled ? "on" : "off", isNoteOffAsVelocityZero ? "on" : "off", midi_get_messages_sent(), numBytes,
+    midi_get_status_bytes_omitted(), numBytes * NumBitsPerMidiByte * 1000000UL / BaudRateMidi);
+  TEST_MESSAGE(message);
+
+  // The counts match the bytes written.
+  TEST_ASSERT_EQUAL(NumNoteTraceEvents, midi_get_messages_sent());
+  TEST_ASSERT_EQUAL(Serial.mWrittenBytes.size(), numBytes);
+  TEST_ASSERT_EQUAL(NumNoteTraceEvents * 3, numBytes + midi_get_status_bytes_omitted());
+}
+
+void test_running_status_off()
+{
+  ReplayNoteTrace(false, false);
+  TEST_ASSERT_EQUAL(66, midi_get_bytes_sent());
+  TEST_ASSERT_EQUAL(0, midi_get_status_bytes_omitted());
+}
+
+void test_running_status_off_note_off_as_velocity_zero()
+{
+  ReplayNoteTrace(false, true);
+  TEST_ASSERT_EQUAL(66, midi_get_bytes_sent());
+  TEST_ASSERT_EQUAL(0, midi_get_status_bytes_omitted());
+}
+
+// Only the 2nd, and 3rd, notes of each chord, press or release, omit their status byte.
+void test_running_status_on()
+{
+  ReplayNoteTrace(true, false);
+  TEST_ASSERT_EQUAL(54, midi_get_bytes_sent());
+  TEST_ASSERT_EQUAL(12, midi_get_status_bytes_omitted());
+
+  // The 1st chord; the status byte, then 3 notes.
+  const uint8_t ChordBytes[] = {0x92, 48, DefaultVelocity, 52, DefaultVelocity, 55, DefaultVelocity};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(ChordBytes, Serial.mWrittenBytes.data() + 6, sizeof(ChordBytes));
+}
+
+// The releases also omit their status byte, until MidiRunningStatusRefreshMs has elapsed since it was last sent.
+void test_running_status_on_note_off_as_velocity_zero()
+{
+  ReplayNoteTrace(true, true);
+  TEST_ASSERT_EQUAL(50, midi_get_bytes_sent());
+  TEST_ASSERT_EQUAL(16, midi_get_status_bytes_omitted());
+
+  // The bass note release, 120 ms after its press.
+  const uint8_t BassNoteBytes[] = {0x91, 36, DefaultVelocity, 36, 0};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(BassNoteBytes, Serial.mWrittenBytes.data(), sizeof(BassNoteBytes));
+
+  // The release of the chord held 400 ms sends its status byte again.
+  const uint8_t HeldChordReleaseBytes[] = {0x92, 48, 0, 52, 0, 55, 0};
+  const uint8_t* lastBytes = Serial.mWrittenBytes.data() + Serial.mWrittenBytes.size() - sizeof(HeldChordReleaseBytes);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(HeldChordReleaseBytes, lastBytes, sizeof(HeldChordReleaseBytes));
+}
+
+// Other traffic cancels the running status; the next note sends its status byte.
+void test_system_exclusive_cancels_running_status()
+{
+  const byte Data[] = {0x7D, 0x01};
+  midi_set_running_status(true, MidiRunningStatusRefreshMs);
+  midi_note_on(0, 60, DefaultVelocity);
+  midi_system_exclusive(Data, sizeof(Data));
+  midi_note_on(0, 62, DefaultVelocity);
+
+  TEST_ASSERT_EQUAL(0, midi_get_status_bytes_omitted());
+  TEST_ASSERT_EQUAL(3 + 4 + 3, midi_get_bytes_sent());
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_running_status_off);
+  RUN_TEST(test_running_status_off_note_off_as_velocity_zero);
+  RUN_TEST(test_running_status_on);
+  RUN_TEST(test_running_status_on_note_off_as_velocity_zero);
+  RUN_TEST(test_system_exclusive_cancels_running_status);
+  return UNITY_END();
+}
@@ -0,0 +1,271 @@
+/*******************************************************************************
+  test_main.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+// Native benchmark of the RH button scan; run with: pio test -e native -f test_scan_benchmark
+// Reads the RH buttons with ButtonsManager::ReadButtons(), through digitalRead() (ENABLE_PORT_REGISTER_SCAN commented out),
+// and through ButtonLayoutScanner (ENABLE_PORT_REGISTER_SCAN); the port input registers are those of the native Arduino core.
+// The host times are only a relative measure; the port input register reads per scan are as on the AVR.
+
+#include <chrono>
+#include <stdio.h>
+#include <unity.h>
+#include <vector>
+
+#include "ButtonsManager.h"
+#include "ButtonLayout.h"
+#include "ButtonPortScanner.h"
+#include "SharedMacros.h"
+
+// Records the button events passed to it, in order.
+class RecordingButtonChangedHandler : public ButtonChangedHandlerBase
+{
+public:
+  virtual void HandleButtonChange(ButtonArray& buttons, byte buttonIndex)
+  {
+    mButtonEvents.push_back(buttonIndex | (buttons.IsActive(buttonIndex) ? 0x80 : 0));
+  }
+
+  // The button index, with bit 7 set for a press.
+  std::vector<uint8_t> mButtonEvents;
+};
+
+// The RH buttons, read by one of the scan paths.
+struct ScanPath
+{
+  ScanPath() :
+    buttons(RightHandButtonPins),
+    buttonPortScanner(buttons),
+    buttonsManager(NULL, &buttons, NULL, NULL)
+  {
+    inputZones[0] = {FirstRightHandKeyIndex, FirstRightHandKeyIndex + NumRightHandKeys - 1, &buttonChangedHandler, BankDebouncePolicies[RightHandKeys]};
+    inputZones[1] = {FirstRightHandCustomButtonIndex, FirstRightHandCustomButtonIndex + NumRightHandCustomButtons - 1, &buttonChangedHandler,
+                     BankDebouncePolicies[RightHandCustomButtons]};
+  }
+
+  // Scans the buttons once, as loop() does.
+  void Scan(bool isPortRegisterScan)
+  {
+    buttonsManager.BeginScanFrame();
+    if (isPortRegisterScan)
+    {
+      buttonsManager.ReadButtons(buttonPortScanner, inputZones, 2, true);
+    }
+    else
+    {
+      buttonsManager.ReadButtons(buttons, inputZones, 2, true);
+    }
+    buttonsManager.DispatchButtonEvents();
+  }
+
+  ButtonArrayOf<NumRightHandButtons> buttons;
+  ButtonLayoutScanner<RightHandButtonLayout> buttonPortScanner;
+  ButtonsManager buttonsManager;
+  RecordingButtonChangedHandler buttonChangedHandler;
+  InputZone inputZones[2];
+};
+
+static const bool DigitalReadScan = false;
+static const bool PortRegisterScan = true;
+
+// The number of scans timed, per repetition; the fastest repetition is reported.
+static const unsigned long NumTimedScans = 20000;
+static const uint8_t NumTimedRepetitions = 5;
+
+static void SetButtonPressed(uint8_t buttonIndex, bool isPressed)
+{
+  uint8_t pin = RightHandButtonPins[buttonIndex];
+  uint8_t& portInputRegister = NativePortInputRegisters()[NativePinToPort[pin]];
+
+  // Input pins are pulled high; a pressed button reads 0.
+  if (isPressed)
+  {
+    portInputRegister &= ~NativePinToBitMask[pin];
+  }
+  else
+  {
+    portInputRegister |= NativePinToBitMask[pin];
+  }
+}
+
+void setUp()
+{
+  NativeMillis() = 0;
+  NativeMicros() = 0;
+  memset(NativePortInputRegisters(), 0xFF, NumMegaPorts);
+}
+
+void tearDown()
+{
+}
+
+// Returns the number of port input register reads of a scan.
+static unsigned long CountPortInputRegisterReads(ScanPath& scanPath, bool isPortRegisterScan)
+{
+  unsigned long numReads = NativeNumPortInputRegisterReads();
+  scanPath.Scan(isPortRegisterScan);
+  return NativeNumPortInputRegisterReads() - numReads;
+}
+
+// Returns the time of a scan, in ns; the fastest of the repetitions.
+static double TimeScan(ScanPath& scanPath, bool isPortRegisterScan)
+{
+  double minScanTimeNs = 0;
+  for (uint8_t repetition = 0; repetition < NumTimedRepetitions; repetition++)
+  {
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < NumTimedScans; i++)
+    {
+      scanPath.Scan(isPortRegisterScan);
+    }
+    std::chrono::duration<double, std::nano> elapsedTime = std::chrono::steady_clock::now() - startTime;
+
+    double scanTimeNs = elapsedTime.count() / NumTimedScans;
+    if (repetition == 0 || scanTimeNs < minScanTimeNs)
+    {
+      minScanTimeNs = scanTimeNs;
+    }
+  }
+
+  return minScanTimeNs;
+}
+
+// The pin map of the native Arduino core matches that of ButtonLayout.h, from which ButtonLayoutScanner reads the ports.
+void test_native_pin_map_matches_button_layout()
+{
+  for (uint8_t pin = 0; pin < NumMegaPins; pin++)
+  {
+    TEST_ASSERT_EQUAL(GetMegaPinPort(pin), NativePinToPort[pin]);
+    TEST_ASSERT_EQUAL(GetMegaPinBitMask(pin), NativePinToBitMask[pin]);
+  }
+}
+
+// Both paths report the same button events, for presses, a bounce, and releases, of keys and custom buttons.
+void test_scan_paths_report_same_events()
+{
+  ScanPath digitalReadPath;
+  ScanPath portRegisterPath;
+
+  // {time, button index, is pressed}
+  const struct { unsigned long timeMs; uint8_t buttonIndex; bool isPressed; } ButtonChanges[] = {
+    {1, 0, true}, {1, 4, true}, {1, 7, true},
+    {3, 40, true},
+    {30, 0, false}, {31, 0, true},
+    {60, 4, false}, {60, 7, false},
+    {61, FirstRightHandCustomButtonIndex, true},
+    {100, 0, false}, {100, 40, false},
+    {130, FirstRightHandCustomButtonIndex, false},
+  };
+
+  unsigned long nextChange = 0;
+  for (unsigned long timeMs = 0; timeMs < 200; timeMs++)
+  {
+    NativeMillis() = timeMs;
+    while (nextChange < COUNT_ENTRIES(ButtonChanges) && ButtonChanges[nextChange].timeMs == timeMs)
+    {
+      SetButtonPressed(ButtonChanges[nextChange].buttonIndex, ButtonChanges[nextChange].isPressed);
+      nextChange++;
+    }
+
+    digitalReadPath.Scan(DigitalReadScan);
+    portRegisterPath.Scan(PortRegisterScan);
+  }
+
+  const std::vector<uint8_t>& events = portRegisterPath.buttonChangedHandler.mButtonEvents;
+  TEST_ASSERT_EQUAL(digitalReadPath.buttonChangedHandler.mButtonEvents.size(), events.size());
+  TEST_ASSERT_TRUE(digitalReadPath.buttonChangedHandler.mButtonEvents == events);
+
+  // Each button pressed, and released, once; the release of key 0 while it bounced is not reported.
+  TEST_ASSERT_EQUAL(10, events.size());
+  TEST_ASSERT_EQUAL(0x80 | 0, events[0]);
+  TEST_ASSERT_EQUAL(0x80 | 40, events[3]);
+  TEST_ASSERT_EQUAL(0, events.back() & 0x80);
+  TEST_ASSERT_EQUAL(0, portRegisterPath.buttons.GetActiveButtons());
+}
+
+// digitalRead() reads a port input register per button; the port register scan reads each port of the layout once.
+void test_port_input_register_reads_per_scan()
+{
+  ScanPath scanPath;
+
+  unsigned long numDigitalReadScanReads = CountPortInputRegisterReads(scanPath, DigitalReadScan);
+  unsigned long numPortRegisterScanReads = CountPortInputRegisterReads(scanPath, PortRegisterScan);
+
+  char message[120];
+  snprintf(message, sizeof(message), "RH scan of %u buttons: digitalRead() %lu port reads, port register scan %lu port reads",
+    NumRightHandButtons, numDigitalReadScanReads, numPortRegisterScanReads);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_EQUAL(NumRightHandButtons, numDigitalReadScanReads);
+  TEST_ASSERT_EQUAL(__builtin_popcount(ButtonPortMask<RightHandButtonLayout, 0, NumRightHandButtons>::Value), numPortRegisterScanReads);
+  TEST_ASSERT_EQUAL(8, numPortRegisterScanReads);
+}
+
+// Times a scan of each path; with no buttons pressed, and with a chord held. In both, no button changes, as in most scans.
+void test_scan_time()
+{
+  const uint8_t ChordButtonIndexes[] = {0, 4, 7, 12};
+  const char* ScenarioNames[] = {"no buttons pressed", "chord held"};
+
+  for (uint8_t scenario = 0; scenario < 2; scenario++)
+  {
+    setUp();
+    for (uint8_t i = 0; scenario == 1 && i < sizeof(ChordButtonIndexes); i++)
+    {
+      SetButtonPressed(ChordButtonIndexes[i], true);
+    }
+
+    ScanPath digitalReadPath;
+    ScanPath portRegisterPath;
+
+    // Let the presses settle, so that each timed scan is a steady state one.
+    NativeMillis() = 0;
+    digitalReadPath.Scan(DigitalReadScan);
+    portRegisterPath.Scan(PortRegisterScan);
+    NativeMillis() = 100;
+
+    double digitalReadScanTimeNs = TimeScan(digitalReadPath, DigitalReadScan);
+    double portRegisterScanTimeNs = TimeScan(portRegisterPath, PortRegisterScan);
+
+    char message[160];
+    snprintf(message, sizeof(message), "RH scan, %s: digitalRead() %.1f ns, port register scan %.1f ns (host); %.1fx",
+      ScenarioNames[scenario], digitalReadScanTimeNs, portRegisterScanTimeNs, digitalReadScanTimeNs / portRegisterScanTimeNs);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL(scenario == 1 ? sizeof(ChordButtonIndexes) : 0, portRegisterPath.buttonChangedHandler.mButtonEvents.size());
+    TEST_ASSERT_TRUE(digitalReadPath.buttonChangedHandler.mButtonEvents == portRegisterPath.buttonChangedHandler.mButtonEvents);
+    TEST_ASSERT_LESS_THAN(digitalReadScanTimeNs, portRegisterScanTimeNs);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_native_pin_map_matches_button_layout);
+  RUN_TEST(test_scan_paths_report_same_events);
+  RUN_TEST(test_port_input_register_reads_per_scan);
+  RUN_TEST(test_scan_time);
+  return UNITY_END();
+}
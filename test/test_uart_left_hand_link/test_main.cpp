@@ -0,0 +1,240 @@
+/*******************************************************************************
+  test_main.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+
+// Native tests of UartLeftHandLink; run with: pio test -e native -f test_uart_left_hand_link
+// The LH Arduino frames are fed to the native Serial2 stand-in; the requests are those of ButtonsManager, with ENABLE_I2C_DELTA_PROTOCOL.
+
+#include <unity.h>
+#include <vector>
+
+#include "UartLeftHandLink.h"
+
+static UartLeftHandLink sLink;
+
+void setUp()
+{
+  UART_LINK_SERIAL.Reset();
+  NativeMillis() = 0;
+  sLink = UartLeftHandLink();
+}
+
+void tearDown()
+{
+}
+
+// Queues the frame passed in, as sent by the LH Arduino, to be read from the UART.
+static void ReceiveFrame(UartLinkFrameType frameType, const std::vector<uint8_t>& payload)
+{
+  std::vector<uint8_t> writtenBytes = UART_LINK_SERIAL.mWrittenBytes;
+  UART_LINK_SERIAL.mWrittenBytes.clear();
+  WriteUartLinkFrame(frameType, payload.data(), payload.size());
+  UART_LINK_SERIAL.mBytesToRead.insert(UART_LINK_SERIAL.mBytesToRead.end(), UART_LINK_SERIAL.mWrittenBytes.begin(), UART_LINK_SERIAL.mWrittenBytes.end());
+  UART_LINK_SERIAL.mWrittenBytes = writtenBytes;
+}
+
+// Starts the request passed in, and returns its reply; PollReply() must return the result passed in.
+static std::vector<uint8_t> Request(uint8_t command, uint8_t numReplyBytes, bool isReplyExpected = true)
+{
+  TEST_ASSERT_TRUE(sLink.StartRequest(&command, 1, numReplyBytes));
+
+  const uint8_t* replyBytes = nullptr;
+  uint8_t numReceivedBytes = 0;
+  bool isFailed = false;
+  TEST_ASSERT_EQUAL(isReplyExpected, sLink.PollReply(replyBytes, numReceivedBytes, isFailed));
+  TEST_ASSERT_FALSE(isFailed);
+  return isReplyExpected ? std::vector<uint8_t>(replyBytes, replyBytes + numReceivedBytes) : std::vector<uint8_t>();
+}
+
+// Returns the commands the link sent to the LH Arduino, and clears them.
+static std::vector<uint8_t> TakeSentCommands()
+{
+  std::vector<uint8_t> commands;
+  UartLinkFrameParser parser;
+  for (uint8_t sentByte : UART_LINK_SERIAL.mWrittenBytes)
+  {
+    if (parser.Parse(sentByte) == UartLinkFrameParser::FrameReceived)
+    {
+      TEST_ASSERT_EQUAL_UINT8(UartLinkCommandFrame, parser.GetFrameType());
+      commands.push_back(parser.GetPayload()[0]);
+    }
+  }
+
+  UART_LINK_SERIAL.mWrittenBytes.clear();
+  return commands;
+}
+
+static const std::vector<uint8_t> Snapshot = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20};
+
+void test_snapshot_reply()
+{
+  // No reply until a snapshot is received.
+  TEST_ASSERT_EQUAL(0, Request(ReadLeftHandSnapshot, NumBytesExpectedFromLeftHandArduino).size());
+
+  ReceiveFrame(UartLinkSnapshotFrame, Snapshot);
+  std::vector<uint8_t> reply = Request(ReadLeftHandSnapshot, NumBytesExpectedFromLeftHandArduino);
+  TEST_ASSERT_EQUAL(Snapshot.size(), reply.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(Snapshot.data(), reply.data(), Snapshot.size());
+
+  // The last snapshot is replied again; nothing is sent to the LH Arduino.
+  TEST_ASSERT_EQUAL(Snapshot.size(), Request(ReadLeftHandSnapshot, NumBytesExpectedFromLeftHandArduino).size());
+  TEST_ASSERT_EQUAL(0, TakeSentCommands().size());
+}
+
+void test_button_event_replies()
+{
+  ReceiveFrame(UartLinkButtonEventFrame, {0x81});
+  ReceiveFrame(UartLinkButtonEventFrame, {0x05});
+
+  std::vector<uint8_t> count = Request(ReadLeftHandEventCount, 1);
+  TEST_ASSERT_EQUAL(1, count.size());
+  TEST_ASSERT_EQUAL_UINT8(2, count[0]);
+
+  std::vector<uint8_t> events = Request(ReadLeftHandEvents, 2);
+  TEST_ASSERT_EQUAL(2, events.size());
+  TEST_ASSERT_EQUAL_HEX8(0x81, events[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x05, events[1]);
+
+  // The replied events are not replied again.
+  count = Request(ReadLeftHandEventCount, 1);
+  TEST_ASSERT_EQUAL_UINT8(0, count[0]);
+}
+
+// The events received before a snapshot are included in it; once it is read, only the later events are replied.
+void test_snapshot_drops_included_button_events()
+{
+  ReceiveFrame(UartLinkButtonEventFrame, {0x81});
+  ReceiveFrame(UartLinkButtonEventFrame, {0x82});
+  ReceiveFrame(UartLinkSnapshotFrame, Snapshot);
+  ReceiveFrame(UartLinkButtonEventFrame, {0x03});
+
+  TEST_ASSERT_EQUAL(Snapshot.size(), Request(ReadLeftHandSnapshot, NumBytesExpectedFromLeftHandArduino).size());
+
+  std::vector<uint8_t> count = Request(ReadLeftHandEventCount, 1);
+  TEST_ASSERT_EQUAL_UINT8(1, count[0]);
+
+  std::vector<uint8_t> events = Request(ReadLeftHandEvents, 1);
+  TEST_ASSERT_EQUAL(1, events.size());
+  TEST_ASSERT_EQUAL_HEX8(0x03, events[0]);
+}
+
+// A dropped frame may have been a button event; the snapshot is then stale, and the LH Arduino is sent RequestLeftHandSnapshot, once.
+void test_dropped_frame_requests_snapshot()
+{
+  ReceiveFrame(UartLinkSnapshotFrame, Snapshot);
+  ReceiveFrame(UartLinkButtonEventFrame, {0x81});
+
+  std::vector<uint8_t> badFrame = {UartLinkFrameSync, UartLinkButtonEventFrame, 1, 0x02, 0x00};
+  UART_LINK_SERIAL.mBytesToRead.insert(UART_LINK_SERIAL.mBytesToRead.end(), badFrame.begin(), badFrame.end());
+  UART_LINK_SERIAL.mBytesToRead.insert(UART_LINK_SERIAL.mBytesToRead.end(), badFrame.begin(), badFrame.end());
+
+  std::vector<uint8_t> count = Request(ReadLeftHandEventCount, 1);
+  TEST_ASSERT_EQUAL_HEX8(LeftHandSnapshotRequired, count[0]);
+
+  std::vector<uint8_t> commands = TakeSentCommands();
+  TEST_ASSERT_EQUAL(1, commands.size());
+  TEST_ASSERT_EQUAL_UINT8(RequestLeftHandSnapshot, commands[0]);
+
+  // No reply from the stale snapshot.
+  TEST_ASSERT_EQUAL(0, Request(ReadLeftHandSnapshot, NumBytesExpectedFromLeftHandArduino).size());
+
+  // The new snapshot includes the queued events, and the lost one.
+  const std::vector<uint8_t> NewSnapshot = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+  ReceiveFrame(UartLinkSnapshotFrame, NewSnapshot);
+  std::vector<uint8_t> reply = Request(ReadLeftHandSnapshot, NumBytesExpectedFromLeftHandArduino);
+  TEST_ASSERT_EQUAL(NewSnapshot.size(), reply.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(NewSnapshot.data(), reply.data(), NewSnapshot.size());
+
+  count = Request(ReadLeftHandEventCount, 1);
+  TEST_ASSERT_EQUAL_UINT8(0, count[0]);
+  TEST_ASSERT_EQUAL(0, TakeSentCommands().size());
+}
+
+// A full button event queue also makes the snapshot stale.
+void test_full_queue_requests_snapshot()
+{
+  for (uint8_t i = 0; i <= LeftHandButtonEventQueueSize; i++)
+  {
+    ReceiveFrame(UartLinkButtonEventFrame, {i});
+  }
+
+  std::vector<uint8_t> count = Request(ReadLeftHandEventCount, 1);
+  TEST_ASSERT_EQUAL_HEX8(LeftHandSnapshotRequired, count[0]);
+
+  std::vector<uint8_t> commands = TakeSentCommands();
+  TEST_ASSERT_EQUAL(1, commands.size());
+  TEST_ASSERT_EQUAL_UINT8(RequestLeftHandSnapshot, commands[0]);
+}
+
+// ReadLeftHandStatus is sent to the LH Arduino, and replied once its status frame is received.
+void test_status_reply()
+{
+  const std::vector<uint8_t> Status(NumLeftHandStatusBytes, 0x07);
+
+  Request(ReadLeftHandStatus, NumLeftHandStatusBytes, false);
+  std::vector<uint8_t> commands = TakeSentCommands();
+  TEST_ASSERT_EQUAL(1, commands.size());
+  TEST_ASSERT_EQUAL_UINT8(ReadLeftHandStatus, commands[0]);
+
+  ReceiveFrame(UartLinkStatusFrame, Status);
+  const uint8_t* replyBytes = nullptr;
+  uint8_t numReplyBytes = 0;
+  bool isFailed = true;
+  TEST_ASSERT_TRUE(sLink.PollReply(replyBytes, numReplyBytes, isFailed));
+  TEST_ASSERT_FALSE(isFailed);
+  TEST_ASSERT_EQUAL(Status.size(), numReplyBytes);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(Status.data(), replyBytes, Status.size());
+}
+
+// Without a status frame, the request fails after UartLinkStatusTimeoutMs, with no reply.
+void test_status_timeout()
+{
+  Request(ReadLeftHandStatus, NumLeftHandStatusBytes, false);
+
+  const uint8_t* replyBytes = nullptr;
+  uint8_t numReplyBytes = 0;
+  bool isFailed = false;
+  NativeMillis() += UartLinkStatusTimeoutMs - 1;
+  TEST_ASSERT_FALSE(sLink.PollReply(replyBytes, numReplyBytes, isFailed));
+
+  NativeMillis() += 1;
+  TEST_ASSERT_TRUE(sLink.PollReply(replyBytes, numReplyBytes, isFailed));
+  TEST_ASSERT_EQUAL(0, numReplyBytes);
+  TEST_ASSERT_TRUE(isFailed);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_snapshot_reply);
+  RUN_TEST(test_button_event_replies);
+  RUN_TEST(test_snapshot_drops_included_button_events);
+  RUN_TEST(test_dropped_frame_requests_snapshot);
+  RUN_TEST(test_full_queue_requests_snapshot);
+  RUN_TEST(test_status_reply);
+  RUN_TEST(test_status_timeout);
+  return UNITY_END();
+}
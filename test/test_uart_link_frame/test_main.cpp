@@ -0,0 +1,272 @@
+/*******************************************************************************
+  test_main.cpp
+  
+  MIDI Electronic Accordion
+  https://github.com/BarryKVibes/MidiElectronicAccordion
+  Copyright 2022, Barry K Vibes
+  
+ *******************************************************************************
+  
+  This file is part of MidiElectronicAccordion.
+  
+  MidiElectronicAccordion is free software: you can redistribute it and/or 
+  modify it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+  
+  MidiElectronicAccordion is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+  GNU General Public License for more details.
+  
+  You should have received a copy of the GNU General Public License along 
+  with MidiElectronicAccordion. If not, see <https://www.gnu.org/licenses/>.
+  
+ ******************************************************************************/
+
+// Native tests of the UART link framing; run with: pio test -e native -f test_uart_link_frame
+// Frames are written by WriteUartLinkFrame() to the native Serial2 stand-in, and its bytes fed back to UartLinkFrameParser.
+
+#include <stdio.h>
+#include <unity.h>
+#include <vector>
+
+#include "UartLinkFrame.h"
+#include "Utilities/Crc8.h"
+
+// A frame received by the parser.
+struct ParsedFrame
+{
+  uint8_t frameType;
+  std::vector<uint8_t> payload;
+};
+
+static UartLinkFrameParser sParser;
+static std::vector<ParsedFrame> sReceivedFrames;
+static unsigned int sNumDroppedFrames;
+
+void setUp()
+{
+  sParser = UartLinkFrameParser();
+  sReceivedFrames.clear();
+  sNumDroppedFrames = 0;
+  UART_LINK_SERIAL.Reset();
+}
+
+void tearDown()
+{
+}
+
+static void Feed(const std::vector<uint8_t>& bytes)
+{
+  for (uint8_t receivedByte : bytes)
+  {
+    UartLinkFrameParser::Result result = sParser.Parse(receivedByte);
+    if (result == UartLinkFrameParser::FrameReceived)
+    {
+      ParsedFrame frame;
+      frame.frameType = sParser.GetFrameType();
+      frame.payload.assign(sParser.GetPayload(), sParser.GetPayload() + sParser.GetNumPayloadBytes());
+      sReceivedFrames.push_back(frame);
+    }
+    else if (result == UartLinkFrameParser::FrameDropped)
+    {
+      sNumDroppedFrames++;
+    }
+  }
+}
+
+// Returns the bytes of the frame passed in, as written to the UART.
+static std::vector<uint8_t> EncodeFrame(UartLinkFrameType frameType, const std::vector<uint8_t>& payload)
+{
+  UART_LINK_SERIAL.Reset();
+  WriteUartLinkFrame(frameType, payload.data(), payload.size());
+  return UART_LINK_SERIAL.mWrittenBytes;
+}
+
+static void AssertFrame(const ParsedFrame& frame, UartLinkFrameType frameType, const std::vector<uint8_t>& payload)
+{
+  TEST_ASSERT_EQUAL_UINT8(frameType, frame.frameType);
+  TEST_ASSERT_EQUAL(payload.size(), frame.payload.size());
+  if (!payload.empty())
+  {
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(payload.data(), frame.payload.data(), payload.size());
+  }
+}
+
+// The CRC-8 check value of the polynomial 0x07, with an initial value of 0, is 0xF4.
+void test_crc8_check_value()
+{
+  const uint8_t CheckBytes[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  TEST_ASSERT_EQUAL_HEX8(0xF4, Crc8(CheckBytes, sizeof(CheckBytes)));
+
+  // Continued over 2 calls.
+  TEST_ASSERT_EQUAL_HEX8(0xF4, Crc8(CheckBytes + 4, 5, Crc8(CheckBytes, 4)));
+}
+
+void test_good_frames_loop_back()
+{
+  const std::vector<uint8_t> SnapshotPayload = {0x01, 0x80, 0x00, 0xFF, 0x12, 0x34};
+  const std::vector<uint8_t> EventPayload = {0x85};
+  const std::vector<uint8_t> CommandPayload = {};
+
+  std::vector<uint8_t> stream = EncodeFrame(UartLinkSnapshotFrame, SnapshotPayload);
+  std::vector<uint8_t> eventFrame = EncodeFrame(UartLinkButtonEventFrame, EventPayload);
+  std::vector<uint8_t> commandFrame = EncodeFrame(UartLinkCommandFrame, CommandPayload);
+  stream.insert(stream.end(), eventFrame.begin(), eventFrame.end());
+  stream.insert(stream.end(), commandFrame.begin(), commandFrame.end());
+
+  // Sync, type, length, payload, and CRC-8; none of the bytes needs escaping.
+  TEST_ASSERT_EQUAL(4 + SnapshotPayload.size() + 4 + EventPayload.size() + 4, stream.size());
+
+  Feed(stream);
+  TEST_ASSERT_EQUAL(0, sNumDroppedFrames);
+  TEST_ASSERT_EQUAL(3, sReceivedFrames.size());
+  AssertFrame(sReceivedFrames[0], UartLinkSnapshotFrame, SnapshotPayload);
+  AssertFrame(sReceivedFrames[1], UartLinkButtonEventFrame, EventPayload);
+  AssertFrame(sReceivedFrames[2], UartLinkCommandFrame, CommandPayload);
+}
+
+// The sync, and escape, bytes of a payload are escaped; so the sync byte is only sent at the start of a frame.
+void test_sync_byte_in_payload_is_escaped()
+{
+  const std::vector<uint8_t> Payload = {UartLinkFrameSync, 0x00, UartLinkFrameEscape, UartLinkFrameSync};
+  std::vector<uint8_t> frame = EncodeFrame(UartLinkSnapshotFrame, Payload);
+
+  unsigned int numSyncBytes = 0;
+  for (uint8_t value : frame)
+  {
+    numSyncBytes += value == UartLinkFrameSync ? 1 : 0;
+  }
+
+  TEST_ASSERT_EQUAL(1, numSyncBytes);
+  TEST_ASSERT_EQUAL_HEX8(UartLinkFrameSync, frame[0]);
+
+  Feed(frame);
+  TEST_ASSERT_EQUAL(0, sNumDroppedFrames);
+  TEST_ASSERT_EQUAL(1, sReceivedFrames.size());
+  AssertFrame(sReceivedFrames[0], UartLinkSnapshotFrame, Payload);
+}
+
+void test_bad_crc_is_dropped()
+{
+  const std::vector<uint8_t> Payload = {0x10, 0x20};
+  std::vector<uint8_t> badFrame = EncodeFrame(UartLinkSnapshotFrame, Payload);
+  badFrame.back() ^= 0x01;
+  std::vector<uint8_t> goodFrame = EncodeFrame(UartLinkButtonEventFrame, {0x03});
+
+  Feed(badFrame);
+  TEST_ASSERT_EQUAL(1, sNumDroppedFrames);
+  TEST_ASSERT_EQUAL(0, sReceivedFrames.size());
+
+  // The next frame is received.
+  Feed(goodFrame);
+  TEST_ASSERT_EQUAL(1, sNumDroppedFrames);
+  TEST_ASSERT_EQUAL(1, sReceivedFrames.size());
+  AssertFrame(sReceivedFrames[0], UartLinkButtonEventFrame, {0x03});
+}
+
+void test_bad_payload_byte_is_dropped()
+{
+  std::vector<uint8_t> badFrame = EncodeFrame(UartLinkSnapshotFrame, {0x10, 0x20, 0x30});
+  badFrame[4] ^= 0x40;
+
+  Feed(badFrame);
+  TEST_ASSERT_EQUAL(1, sNumDroppedFrames);
+  TEST_ASSERT_EQUAL(0, sReceivedFrames.size());
+}
+
+void test_bad_length_is_dropped()
+{
+  // Sync, type, and a length longer than MaxUartLinkPayloadBytes; the rest of the frame is skipped until the next sync byte.
+  std::vector<uint8_t> stream = {UartLinkFrameSync, UartLinkSnapshotFrame, MaxUartLinkPayloadBytes + 1, 0x00, 0x11, 0x22};
+  std::vector<uint8_t> goodFrame = EncodeFrame(UartLinkButtonEventFrame, {0x07});
+  stream.insert(stream.end(), goodFrame.begin(), goodFrame.end());
+
+  Feed(stream);
+  TEST_ASSERT_EQUAL(1, sNumDroppedFrames);
+  TEST_ASSERT_EQUAL(1, sReceivedFrames.size());
+  AssertFrame(sReceivedFrames[0], UartLinkButtonEventFrame, {0x07});
+}
+
+// A frame cut short, e.g. by a lost byte, is dropped at the next sync byte, and the frame it starts is received;
+// the parser does not read the next frame as the rest of the one cut short.
+void test_resync_on_sync_byte_inside_frame()
+{
+  const std::vector<uint8_t> Payload = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+  std::vector<uint8_t> cutFrame = EncodeFrame(UartLinkSnapshotFrame, Payload);
+  cutFrame.resize(5);
+  std::vector<uint8_t> goodFrame = EncodeFrame(UartLinkSnapshotFrame, Payload);
+
+  std::vector<uint8_t> stream = cutFrame;
+  stream.insert(stream.end(), goodFrame.begin(), goodFrame.end());
+
+  Feed(stream);
+  TEST_ASSERT_EQUAL(1, sNumDroppedFrames);
+  TEST_ASSERT_EQUAL(1, sReceivedFrames.size());
+  AssertFrame(sReceivedFrames[0], UartLinkSnapshotFrame, Payload);
+}
+
+// An unescaped sync byte inside a payload, e.g. from noise, restarts the parser; that frame is dropped, and the next one is received.
+void test_resync_on_raw_sync_byte_inside_payload()
+{
+  std::vector<uint8_t> noisyFrame = EncodeFrame(UartLinkSnapshotFrame, {0x01, 0x02, 0x03, 0x04});
+  noisyFrame[4] = UartLinkFrameSync;
+  std::vector<uint8_t> goodFrame = EncodeFrame(UartLinkButtonEventFrame, {0x09});
+
+  std::vector<uint8_t> stream = noisyFrame;
+  stream.insert(stream.end(), goodFrame.begin(), goodFrame.end());
+
+  Feed(stream);
+  TEST_ASSERT_EQUAL(1, sReceivedFrames.size());
+  AssertFrame(sReceivedFrames[0], UartLinkButtonEventFrame, {0x09});
+  TEST_ASSERT_TRUE(sNumDroppedFrames >= 1);
+}
+
+// Calculates, rather than measures, the wire time of the LH button states over each link, from the frames as encoded; at 10 bits per UART byte,
+// and 9 bits per I2C byte (8 data bits, and the acknowledge), plus the start, and stop, conditions of each transfer.
+// Over I2C, the RH Arduino reads the snapshot each time it polls, as ButtonsManager::FetchLeftHandArduinoButtons() does
+// without ENABLE_I2C_DELTA_PROTOCOL; over UART, the LH Arduino sends a button event frame once, as soon as the button changes.
+void test_link_wire_time_calculation()
+{
+  std::vector<uint8_t> snapshotPayload(NumBytesExpectedFromLeftHandArduino, 0x00);
+  unsigned long numSnapshotFrameBytes = EncodeFrame(UartLinkSnapshotFrame, snapshotPayload).size();
+  unsigned long numEventFrameBytes = EncodeFrame(UartLinkButtonEventFrame, {0x01}).size();
+
+  unsigned long uartSnapshotMicroseconds = numSnapshotFrameBytes * 10 * 1000000UL / LeftHandLinkBaudRate;
+  unsigned long uartEventMicroseconds = numEventFrameBytes * 10 * 1000000UL / LeftHandLinkBaudRate;
+
+  // Address byte, and the snapshot bytes.
+  unsigned long i2cSnapshotBits = (1 + NumBytesExpectedFromLeftHandArduino) * 9 + 2;
+  unsigned long i2c100kHzMicroseconds = i2cSnapshotBits * 1000000UL / 100000;
+  unsigned long i2c400kHzMicroseconds = i2cSnapshotBits * 1000000UL / 400000;
+
+  char message[160];
+  snprintf(message, sizeof(message), "Calculated: UART %lu baud: event frame %lu B = %lu us, snapshot frame %lu B = %lu us; max %lu events/s",
+    LeftHandLinkBaudRate, numEventFrameBytes, uartEventMicroseconds, numSnapshotFrameBytes, uartSnapshotMicroseconds,
+    LeftHandLinkBaudRate / 10 / numEventFrameBytes);
+  TEST_MESSAGE(message);
+  snprintf(message, sizeof(message), "Calculated: I2C snapshot poll %lu bits: 100 kHz = %lu us (max %lu polls/s), 400 kHz = %lu us (max %lu polls/s)",
+    i2cSnapshotBits, i2c100kHzMicroseconds, 1000000UL / i2c100kHzMicroseconds, i2c400kHzMicroseconds, 1000000UL / i2c400kHzMicroseconds);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_EQUAL(5, numEventFrameBytes);
+  TEST_ASSERT_EQUAL(4 + NumBytesExpectedFromLeftHandArduino, numSnapshotFrameBytes);
+  TEST_ASSERT_LESS_THAN(i2c400kHzMicroseconds, uartEventMicroseconds);
+  TEST_ASSERT_LESS_THAN(i2c400kHzMicroseconds, uartSnapshotMicroseconds);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_crc8_check_value);
+  RUN_TEST(test_good_frames_loop_back);
+  RUN_TEST(test_sync_byte_in_payload_is_escaped);
+  RUN_TEST(test_bad_crc_is_dropped);
+  RUN_TEST(test_bad_payload_byte_is_dropped);
+  RUN_TEST(test_bad_length_is_dropped);
+  RUN_TEST(test_resync_on_sync_byte_inside_frame);
+  RUN_TEST(test_resync_on_raw_sync_byte_inside_payload);
+  RUN_TEST(test_link_wire_time_calculation);
+  return UNITY_END();
+}